@@ -0,0 +1,72 @@
+/**
+ * @file args.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Log argument types that can be stored as raw bytes, and not
+ *        formatted by the caller
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_ARGS_HPP_
+#define COMPONENTS_LG_ARGS_HPP_
+
+#include <cstddef>
+#include <cstring>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lg {
+namespace detail {
+
+template<typename T>
+using arg_type = std::remove_cvref_t<T>;
+
+template<typename T>
+inline constexpr bool is_string_arg_v =
+  std::is_same_v<std::decay_t<arg_type<T>>, char*> ||
+  std::is_same_v<std::decay_t<arg_type<T>>, const char*> ||
+  std::is_same_v<arg_type<T>, std::string_view> ||
+  std::is_same_v<arg_type<T>, std::string>;
+
+/**
+ * Copied as raw bytes
+ */
+template<typename T>
+inline constexpr bool is_value_arg_v =
+  std::is_arithmetic_v<arg_type<T>> ||
+  std::is_enum_v<arg_type<T>> ||
+  std::is_same_v<arg_type<T>, std::nullptr_t> ||
+  std::is_same_v<arg_type<T>, void*> ||
+  std::is_same_v<arg_type<T>, const void*>;
+
+template<typename T>
+inline constexpr bool is_deferrable_v = is_value_arg_v<T> || is_string_arg_v<T>;
+
+/**
+ * Type given to the formatter when decoded: strings point to the copy
+ * inside the record
+ */
+template<typename T>
+using decoded_t = std::conditional_t<is_string_arg_v<T>,
+                                     std::string_view,
+                                     arg_type<T>>;
+
+template<typename T>
+std::string_view
+as_string(const T& arg) noexcept {
+  if constexpr (std::is_array_v<T>)
+    return std::string_view(arg, strnlen(arg, std::extent_v<T>));
+  else if constexpr (std::is_pointer_v<T>)
+    return arg ? std::string_view(arg) : std::string_view("(null)");
+  else
+    return std::string_view(arg);
+}
+
+}  // namespace detail
+}  // namespace lg
+
+#endif  // COMPONENTS_LG_ARGS_HPP_
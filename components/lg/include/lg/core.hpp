@@ -13,9 +13,13 @@
 
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include <utility>
 #include <string_view>
 
+#include "sdkconfig.h"
+
 #include "esp_system.h"
 
 #define FMT_THROW(x)  esp_system_abort(x.what())
@@ -25,6 +29,13 @@
 
 #include "esp_log.h"
 
+#include "lg/levels.hpp"
+#include "lg/sink.hpp"
+
+#ifndef CONFIG_LG_BUFFER_SIZE
+#define CONFIG_LG_BUFFER_SIZE   256
+#endif
+
 namespace lg {
 
 /**
@@ -66,6 +77,14 @@ print(const fmt::text_style& ts,  S& fmt, Args&&... args) {
             ts, fmt, std::forward<Args>(args)...);
 }
 
+/**
+ * Writes 'size' bytes at once to stdout
+ */
+inline void
+write(const char* data, std::size_t size) noexcept {
+  stdout_sink::write(data, size);
+}
+
 struct timestamp {
   static
   std::uint32_t time() {
@@ -96,12 +115,17 @@ char* end_color = "" LOG_RESET_COLOR;
 #define CONFIG_LG_USE_COLOR    false
 #endif 
 
+/**
+ * 'Sink': where the records are written (lg/sink.hpp)
+ */
 template<bool BreakLine = true,
          bool UseColor = CONFIG_LG_USE_COLOR,
          typename TimeFunc = timestamp,
-         bool Force    = false>
+         bool Force    = false,
+         sink Sink     = stdout_sink>
 struct config {
   using time = TimeFunc;
+  using sink = Sink;
   static constexpr const bool break_line  = BreakLine;
   static constexpr const bool color       = UseColor;
   static constexpr const bool force       = Force;
@@ -109,25 +133,159 @@ struct config {
 
 using default_config = config<>;
 
+namespace detail {
+
+/**
+ * Bounded writer to a record buffer
+ */
+class record {
+ public:
+  static constexpr const std::string_view ellipsis = "...";
+
+  constexpr
+  record(char* buffer, std::size_t size) noexcept
+   : buffer_(buffer), size_(size) {}
+
+  template<typename ...Args>
+  void format(fmt::format_string<Args...> fmt, Args&& ...args) noexcept {
+    auto const result = fmt::format_to_n(buffer_ + used_, size_ - used_,
+                                         fmt, std::forward<Args>(args)...);
+    if (result.size > size_ - used_) {
+      used_ = size_;
+      truncated_ = true;
+    } else
+      used_ += result.size;
+  }
+
+  void append(std::string_view str) noexcept {
+    std::size_t const n = std::min(str.size(), size_ - used_);
+    std::memcpy(buffer_ + used_, str.data(), n);
+    used_ += n;
+    truncated_ = truncated_ || n != str.size();
+  }
+
+  /**
+   * Marks a truncated record with "...", not splitting a UTF-8 character
+   */
+  void finish() noexcept {
+    if (!truncated_ || size_ < ellipsis.size())
+      return;
+    used_ = size_ - ellipsis.size();
+    while (used_ > 0 && (buffer_[used_] & 0xC0) == 0x80)
+      --used_;
+    std::memcpy(buffer_ + used_, ellipsis.data(), ellipsis.size());
+    used_ += ellipsis.size();
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  size() const noexcept {
+    return used_;
+  }
+
+  [[nodiscard]] constexpr bool
+  truncated() const noexcept {
+    return truncated_;
+  }
+
+ private:
+  char*       buffer_;
+  std::size_t size_;
+  std::size_t used_ = 0;
+  bool        truncated_ = false;
+};
+
+/**
+ * Formats the complete record (color, header, message, color reset and
+ * line break) at 'buffer'. Returns its size.
+ */
+template<typename Level,
+         typename Config,
+         typename Time,
+         typename ...T>
+std::size_t
+format_record(char* buffer, std::size_t size,
+              const Time& time,
+              std::string_view tag,
+              fmt::format_string<T...> fmt,
+              T&& ...args) noexcept {
+  constexpr std::string_view reset{end_color};
+  constexpr std::size_t tail = reset.size() + Config::break_line;
+
+  record rec(buffer, size - tail);
+  if constexpr (Config::color)
+    rec.append(Level::color);
+  rec.format("{} ({}) {}:",
+             Level::letter,
+             time,
+             tag);
+  rec.format(fmt, std::forward<T>(args)...);
+  rec.finish();
+
+  std::size_t used = rec.size();
+  std::memcpy(buffer + used, reset.data(), reset.size());
+  used += reset.size();
+  if constexpr (Config::break_line)
+    buffer[used++] = '\n';
+  return used;
+}
+
+/**
+ * Formats at a CONFIG_LG_BUFFER_SIZE stack buffer and writes with one call
+ * to the config sink
+ */
+template<typename Level,
+         typename Config,
+         typename ...T>
+void
+write_record(std::string_view tag,
+             fmt::format_string<T...> fmt,
+             T&& ...args) noexcept {
+  static_assert(CONFIG_LG_BUFFER_SIZE >= 64, "CONFIG_LG_BUFFER_SIZE too small");
+
+  char buffer[CONFIG_LG_BUFFER_SIZE];
+  Config::sink::write(buffer,
+                      format_record<Level, Config>(buffer, sizeof(buffer),
+                                                   Config::time::time(),
+                                                   tag, fmt, std::forward<T>(args)...));
+}
+
+/**
+ * Config with a deferred backend (see lg/deferred.hpp)
+ */
+template<typename Config>
+concept deferred_config = requires {
+  typename Config::deferred;
+};
+
+}  // namespace detail
+
+/**
+ * The record is formatted at a CONFIG_LG_BUFFER_SIZE stack buffer and
+ * written with one call, so records of different tasks don't interleave.
+ * The color reset and line break are always kept at a truncated record.
+ *
+ * Deferred configs only store the record, to be formatted by the drain
+ * task.
+ *
+ * The runtime level of the tag (lg/levels.hpp) is checked before anything
+ * is formatted or stored (not for 'force' configs).
+ */
 template<typename Level,
          typename Config = default_config,
          typename ...T>
 constexpr void
-out(std::string_view tag,
+out(tag_view tag,
       fmt::format_string<T...> fmt,
       T&& ...args) {
   if constexpr (Config::force || Level::level <= LOG_LOCAL_LEVEL) {
-    if constexpr (Config::color)
-      lg::print("{}", Level::color);
-    lg::print("{} ({}) {}:",
-              Level::letter,
-              Config::time::time(),
-              tag);
-    lg::print(fmt,
-              std::forward<T>(args)...);
-    lg::print("{}", end_color);
-    if constexpr (Config::break_line)
-      lg::print("\n");
+    if constexpr (!Config::force)
+      if (!enabled(Level::level, tag))
+        return;
+    if constexpr (detail::deferred_config<Config>)
+      Config::deferred::template push<Level, Config>(tag.name(), fmt,
+                                                     std::forward<T>(args)...);
+    else
+      detail::write_record<Level, Config>(tag.name(), fmt, std::forward<T>(args)...);
   }
 }
 
@@ -135,11 +293,22 @@ out(std::string_view tag,
 template<typename Config = default_config,    \
          typename ...T>                       \
 constexpr void                                \
-name (std::string_view tag,                   \
+name (tag_view tag,                           \
       fmt::format_string<T...> fmt,           \
       T&& ...args) {                          \
   out< name ## _level, Config, T...>(         \
         tag, fmt, std::forward<T>(args)...);  \
+}                                             \
+                                              \
+template<typename Config = default_config,    \
+         fixed_string Format,                 \
+         typename ...T>                       \
+constexpr void                                \
+name (tag_view tag,                           \
+      format_literal<Format> fmt,             \
+      T&& ...args) {                          \
+  out< name ## _level, Config>(               \
+        tag, fmt, std::forward<T>(args)...);  \
 }
 
 #define LOG_FUNC_EMPTY(name)                  \
@@ -0,0 +1,411 @@
+/**
+ * @file deferred.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Deferred logging: the caller stores the raw arguments at a lock
+ *        free ring, a low priority task formats and writes them
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * using fast = lg::deferred_config<lg::default_deferred>;
+ *
+ * lg::default_deferred::start();       // Drain task
+ * lg::info<fast>("ADC", "{} samples, rms {}", size, rms);
+ * lg::log<fast> ll{"ADC"};
+ */
+#ifndef COMPONENTS_LG_DEFERRED_HPP_
+#define COMPONENTS_LG_DEFERRED_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "lg/core.hpp"
+#include "lg/level.hpp"
+#include "lg/args.hpp"
+
+#ifndef CONFIG_LG_DEFERRED_RECORDS
+#define CONFIG_LG_DEFERRED_RECORDS      32
+#endif
+
+#ifndef CONFIG_LG_DEFERRED_RECORD_SIZE
+#define CONFIG_LG_DEFERRED_RECORD_SIZE  64
+#endif
+
+namespace lg {
+
+namespace detail {
+
+template<typename T>
+std::size_t
+encoded_size(const T& arg) noexcept {
+  if constexpr (is_string_arg_v<T>)
+    return sizeof(std::uint16_t) + as_string(arg).size();
+  else
+    return sizeof(T);
+}
+
+template<typename T>
+std::uint8_t*
+encode(std::uint8_t* out, const T& arg) noexcept {
+  if constexpr (is_string_arg_v<T>) {
+    auto const str = as_string(arg);
+    auto const size = static_cast<std::uint16_t>(str.size());
+    std::memcpy(out, &size, sizeof(size));
+    std::memcpy(out + sizeof(size), str.data(), size);
+    return out + sizeof(size) + size;
+  } else {
+    std::memcpy(out, &arg, sizeof(T));
+    return out + sizeof(T);
+  }
+}
+
+template<typename T>
+decoded_t<T>
+decode(const std::uint8_t*& in) noexcept {
+  if constexpr (is_string_arg_v<T>) {
+    std::uint16_t size;
+    std::memcpy(&size, in, sizeof(size));
+    std::string_view const str(reinterpret_cast<const char*>(in + sizeof(size)), size);
+    in += sizeof(size) + size;
+    return str;
+  } else {
+    arg_type<T> value;
+    std::memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+    return value;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Lock free multiple producer / single consumer ring of fixed size
+ * records (bounded queue of D. Vyukov). All state is static: each
+ * instantiation is one ring.
+ *
+ * A record holds the address of its decoder (one instantiation per
+ * level/config/argument types, the format string identifier), the format
+ * string and tag addresses, the timestamp and the raw arguments. Strings
+ * arguments are copied. Format strings and tags must be static (literals,
+ * as used with lg::log).
+ *
+ * The caller falls back to format and write the record itself (eager) if
+ * any argument is not a arithmetic/enum/pointer/string type, the time
+ * function doesn't return a integer, or the record doesn't fit 'RecordSize'.
+ * If the ring is full the record is dropped, and a warning with the count
+ * is written at the next drain, with the 'Report' config (its sink, format
+ * and time).
+ */
+template<std::size_t Records = CONFIG_LG_DEFERRED_RECORDS,
+         std::size_t RecordSize = CONFIG_LG_DEFERRED_RECORD_SIZE,
+         typename Report = default_config>
+class basic_deferred {
+ public:
+  static_assert(Records >= 2 && (Records & (Records - 1)) == 0,
+                "Records must be a power of 2");
+
+  struct statistics {
+    std::uint32_t deferred;
+    std::uint32_t eager;
+    std::uint32_t dropped;
+  };
+
+  template<typename Level,
+           typename Config,
+           typename ...T>
+  static void
+  push(std::string_view tag,
+       fmt::format_string<T...> fmt,
+       T&& ...args) noexcept {
+    using time_type = decltype(Config::time::time());
+    if constexpr (!(detail::is_deferrable_v<T> && ...) ||
+                  !std::is_integral_v<time_type>) {
+      eager<Level, Config>(tag, fmt, std::forward<T>(args)...);
+    } else {
+      fmt::string_view const format = fmt;
+      if (!store<Config>(&decode<Level, Config, T...>, format.data(), format.size(),
+                         tag, args...))
+        eager<Level, Config>(tag, fmt, std::forward<T>(args)...);
+    }
+  }
+
+  /**
+   * Stores a record to be written by the drain as 'Writer::write(time, tag,
+   * values...)' (values as decoded_t<T>), instead of formatted: e.g. the
+   * binary records of lg/strip.hpp, where the format id is part of
+   * 'Writer'. Records that don't fit 'RecordSize' are written by the caller.
+   */
+  template<typename Writer,
+           typename Config,
+           typename ...T>
+  static void
+  push_writer(std::string_view tag, const T& ...args) noexcept {
+    static_assert((detail::is_deferrable_v<T> && ...) &&
+                  std::is_integral_v<decltype(Config::time::time())>,
+                  "Arguments/time not deferrable");
+    if (!store<Config>(&write_as<Writer, T...>, nullptr, 0, tag, args...)) {
+      eager_.fetch_add(1, std::memory_order_relaxed);
+      Writer::write(static_cast<std::uint32_t>(Config::time::time()), tag, args...);
+    }
+  }
+
+  /**
+   * Formats and writes all stored records, each to the sink of its
+   * config. Must be called from one task only (the drain task, or while it
+   * is stopped). Returns the records written.
+   */
+  static std::size_t
+  drain() noexcept {
+    char buffer[CONFIG_LG_BUFFER_SIZE];
+    std::size_t count = 0;
+
+    auto const dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_) {
+      Report::sink::write(buffer,
+                          detail::format_record<warn_level, Report>(
+                            buffer, sizeof(buffer), Report::time::time(), "lg",
+                            "{} records dropped", dropped - reported_));
+      reported_ = dropped;
+    }
+
+    while (true) {
+      std::uint32_t const index = tail_ & mask;
+      cell& c = cells_[index];
+      if (c.seq.load(std::memory_order_acquire) + index != tail_ + 1)
+        break;
+
+      header hdr;
+      std::memcpy(&hdr, c.data, sizeof(hdr));
+      hdr.decode(hdr, c.data + sizeof(hdr), buffer, sizeof(buffer));
+
+      c.seq.store(tail_ + Records - index, std::memory_order_release);
+      ++tail_;
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * Creates the drain task, that drains every 'period_ms'
+   */
+  static bool
+  start(UBaseType_t priority = 1,
+        std::uint32_t stack = 3072,
+        BaseType_t core = tskNO_AFFINITY,
+        std::uint32_t period_ms = 20) noexcept {
+    if (running_.exchange(true, std::memory_order_acq_rel))
+      return false;
+    period_ = period_ms;
+    finished_.store(false, std::memory_order_release);
+    if (xTaskCreatePinnedToCore(task, "lg drain", stack, nullptr,
+                                priority, nullptr, core) != pdPASS) {
+      finished_.store(true, std::memory_order_release);
+      running_.store(false, std::memory_order_release);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Stops the drain task after a last drain
+   */
+  static void
+  stop() noexcept {
+    if (!running_.exchange(false, std::memory_order_acq_rel))
+      return;
+    while (!finished_.load(std::memory_order_acquire))
+      vTaskDelay(1);
+  }
+
+  [[nodiscard]] static statistics
+  stats() noexcept {
+    return {
+      deferred_.load(std::memory_order_relaxed),
+      eager_.load(std::memory_order_relaxed),
+      dropped_.load(std::memory_order_relaxed)
+    };
+  }
+
+ private:
+  struct header;
+  using decoder = void(*)(const header&, const std::uint8_t*,
+                          char*, std::size_t);
+
+  struct header {
+    decoder       decode;
+    const char*   format;
+    const char*   tag;
+    std::uint16_t format_size;
+    std::uint16_t tag_size;
+    std::uint32_t time;
+  };
+
+  static_assert(RecordSize >= sizeof(header) + 8, "RecordSize too small");
+
+  /**
+   * 'seq' is stored minus the cell index, so the initial (zero) state is
+   * the sequence of a empty ring
+   */
+  struct cell {
+    std::atomic<std::uint32_t>  seq{0};
+    alignas(4) std::uint8_t     data[RecordSize];
+  };
+
+  static constexpr const std::uint32_t mask = Records - 1;
+
+  /**
+   * False if the record doesn't fit 'RecordSize'. If the ring is full it is
+   * dropped (counted).
+   */
+  template<typename Config,
+           typename ...T>
+  static bool
+  store(decoder dec,
+        const char* format, std::size_t format_size,
+        std::string_view tag,
+        const T& ...args) noexcept {
+    std::size_t const size = sizeof(header) + (detail::encoded_size(args) + ... + 0);
+    if (size > RecordSize)
+      return false;
+
+    cell* c = claim();
+    if (!c) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    header const hdr{
+      dec,
+      format, tag.data(),
+      static_cast<std::uint16_t>(format_size),
+      static_cast<std::uint16_t>(tag.size()),
+      static_cast<std::uint32_t>(Config::time::time())
+    };
+    std::memcpy(c->data, &hdr, sizeof(hdr));
+    [[maybe_unused]] std::uint8_t* out = c->data + sizeof(hdr);
+    ((out = detail::encode(out, args)), ...);
+    publish(c);
+    deferred_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  template<typename Level,
+           typename Config,
+           typename ...T>
+  static void
+  eager(std::string_view tag,
+        fmt::format_string<T...> fmt,
+        T&& ...args) noexcept {
+    eager_.fetch_add(1, std::memory_order_relaxed);
+    detail::write_record<Level, Config>(tag, fmt, std::forward<T>(args)...);
+  }
+
+  template<typename Level,
+           typename Config,
+           typename ...T>
+  static void
+  decode(const header& hdr, [[maybe_unused]] const std::uint8_t* args,
+         char* buffer, std::size_t size) noexcept {
+    // Braced initialization: decoded in order
+    std::tuple<detail::decoded_t<T>...> const values{detail::decode<T>(args)...};
+    Config::sink::write(buffer, std::apply([&](const auto& ...values) {
+      return detail::format_record<Level, Config>(
+                buffer, size, hdr.time,
+                std::string_view(hdr.tag, hdr.tag_size),
+                fmt::runtime(std::string_view(hdr.format, hdr.format_size)),
+                values...);
+    }, values));
+  }
+
+  template<typename Writer,
+           typename ...T>
+  static void
+  write_as(const header& hdr, [[maybe_unused]] const std::uint8_t* args,
+           char*, std::size_t) noexcept {
+    // Braced initialization: decoded in order
+    std::tuple<detail::decoded_t<T>...> const values{detail::decode<T>(args)...};
+    std::apply([&](const auto& ...values) {
+      Writer::write(hdr.time, std::string_view(hdr.tag, hdr.tag_size), values...);
+    }, values);
+  }
+
+  static cell*
+  claim() noexcept {
+    std::uint32_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      cell& c = cells_[pos & mask];
+      auto const seq = c.seq.load(std::memory_order_acquire) + (pos & mask);
+      auto const diff = static_cast<std::int32_t>(seq - pos);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          return &c;
+      } else if (diff < 0) {
+        return nullptr;     // Full
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static void
+  publish(cell* c) noexcept {
+    auto const pos = c->seq.load(std::memory_order_relaxed);
+    c->seq.store(pos + 1, std::memory_order_release);
+  }
+
+  static void
+  task(void*) noexcept {
+    while (running_.load(std::memory_order_acquire)) {
+      drain();
+      vTaskDelay(pdMS_TO_TICKS(period_));
+    }
+    drain();
+    finished_.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+  }
+
+  static inline std::array<cell, Records>   cells_{};
+  static inline std::atomic<std::uint32_t>  head_{0};
+  static inline std::uint32_t               tail_ = 0;
+  static inline std::uint32_t               reported_ = 0;
+
+  static inline std::atomic<std::uint32_t>  deferred_{0};
+  static inline std::atomic<std::uint32_t>  eager_{0};
+  static inline std::atomic<std::uint32_t>  dropped_{0};
+
+  static inline std::atomic<bool>           running_{false};
+  static inline std::atomic<bool>           finished_{true};
+  static inline std::uint32_t               period_ = 20;
+};
+
+using default_deferred = basic_deferred<>;
+
+/**
+ * lg::config that stores the records at 'Deferred'
+ */
+template<typename Deferred = default_deferred,
+         bool BreakLine = true,
+         bool UseColor = CONFIG_LG_USE_COLOR,
+         typename TimeFunc = timestamp,
+         bool Force    = false,
+         sink Sink     = stdout_sink>
+struct deferred_config : config<BreakLine, UseColor, TimeFunc, Force, Sink> {
+  using deferred = Deferred;
+};
+
+}  // namespace lg
+
+#endif  // COMPONENTS_LG_DEFERRED_HPP_
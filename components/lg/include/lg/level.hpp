@@ -14,6 +14,7 @@
 #include "esp_log.h"
 
 #include "lg/core.hpp"
+#include "lg/strip.hpp"
 
 #include "fmt/color.h"
 
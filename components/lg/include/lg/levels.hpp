@@ -0,0 +1,436 @@
+/**
+ * @file levels.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Runtime log levels per tag
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * lg::set_level("wifi", lg::level::debug);
+ * lg::set_default_level(lg::level::warn);
+ * lg::apply_levels("*:W,wifi:D,adc:I");     // e.g. from a HTTP request body
+ *
+ * char buffer[lg::levels_string_size];
+ * lg::format_levels(buffer, sizeof(buffer));  // "*:W,wifi:D,adc:I"
+ *
+ * See sys/log_levels.hpp to persist at NVS.
+ *
+ * Levels are the Level::level values (0 none, 1 error ... 5 verbose). The
+ * compile time filter (LOG_LOCAL_LEVEL) is applied first: runtime levels
+ * can only hide records. The default level is verbose (nothing hidden).
+ */
+#ifndef COMPONENTS_LG_LEVELS_HPP_
+#define COMPONENTS_LG_LEVELS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <string_view>
+#include <type_traits>
+
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifndef CONFIG_LG_TAG_LEVELS
+#define CONFIG_LG_TAG_LEVELS    16
+#endif
+
+#ifndef CONFIG_LG_TAG_SIZE
+#define CONFIG_LG_TAG_SIZE      16
+#endif
+
+namespace lg {
+
+enum class level : int {
+  none    = 0,
+  error   = 1,
+  warn    = 2,
+  info    = 3,
+  debug   = 4,
+  verbose = 5
+};
+
+namespace detail {
+
+constexpr std::uint32_t
+tag_hash(std::string_view tag) noexcept {
+  std::uint32_t hash = 2166136261u;
+  for (char c : tag) {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash ? hash : 1;     // 0: empty slot
+}
+
+}  // namespace detail
+
+/**
+ * Tag and its hash. String literals (lg::info("ADC", ...)) are hashed at
+ * compile time and lg::log hashes once at construction. Tags built at
+ * runtime (pointers, std::string, char buffers) are only hashed when the
+ * runtime levels are looked up.
+ */
+class tag_view {
+ public:
+  template<std::size_t N>
+  consteval
+  tag_view(const char (&name)[N]) noexcept
+   : name_(name), hash_(detail::tag_hash(name_)) {}
+
+  template<std::size_t N>
+  constexpr
+  tag_view(char (&name)[N]) noexcept
+   : name_(name) {}
+
+  template<typename T>
+    requires std::is_convertible_v<const T&, std::string_view>
+  constexpr
+  tag_view(const T& name) noexcept
+   : name_(name) {}
+
+  [[nodiscard]] constexpr std::string_view
+  name() const noexcept {
+    return name_;
+  }
+
+  [[nodiscard]] constexpr std::uint32_t
+  hash() const noexcept {
+    return hash_ ? hash_ : detail::tag_hash(name_);
+  }
+
+  [[nodiscard]] constexpr tag_view
+  hashed() const noexcept {
+    tag_view tag = *this;
+    tag.hash_ = detail::tag_hash(name_);
+    return tag;
+  }
+
+ private:
+  std::string_view  name_;
+  std::uint32_t     hash_ = 0;
+};
+
+inline constexpr std::size_t levels_string_size =
+                          4 + CONFIG_LG_TAG_LEVELS * (CONFIG_LG_TAG_SIZE + 3);
+
+namespace detail {
+
+/**
+ * Open addressing table (linear probing) of tag hashes. Lookups are lock
+ * free; writers (rare) are serialized by a lock that, as ring_sink, tries
+ * a few times and then sleeps a tick (the holder may be a lower priority
+ * task of the same core). Entries are only
+ * removed all together (reset()): a tag set back to the default keeps its
+ * slot. Tags with the same hash share the level.
+ */
+class level_table {
+ public:
+  static constexpr const std::size_t capacity =
+                      std::bit_ceil(std::size_t{2} * CONFIG_LG_TAG_LEVELS);
+  static constexpr const std::size_t mask = capacity - 1;
+
+  /**
+   * Cheap check first: 'lvl' above all levels set
+   */
+  [[nodiscard]] bool
+  enabled(int lvl, const tag_view& tag) const noexcept {
+    if (lvl > max_.load(std::memory_order_relaxed))
+      return false;
+    if (count_.load(std::memory_order_relaxed) == 0)
+      return true;
+    return lvl <= get(tag.hash());
+  }
+
+  [[nodiscard]] int
+  get(std::uint32_t hash) const noexcept {
+    for (std::size_t i = 0; i < capacity; ++i) {
+      auto const& s = slots_[(hash + i) & mask];
+      auto const key = s.key.load(std::memory_order_acquire);
+      if (key == 0)
+        break;
+      if (key == hash) {
+        // 0: default
+        auto const value = s.value.load(std::memory_order_relaxed);
+        if (value != 0)
+          return value - 1;
+        break;
+      }
+    }
+    return default_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * level -1: back to the default. False if the table is full or the tag
+   * is longer than CONFIG_LG_TAG_SIZE.
+   */
+  bool set(std::string_view tag, int lvl) noexcept {
+    if (tag.size() > CONFIG_LG_TAG_SIZE)
+      return false;
+    guard g(lock_);
+    std::uint32_t const hash = tag_hash(tag);
+    for (std::size_t i = 0; i < capacity; ++i) {
+      auto& s = slots_[(hash + i) & mask];
+      auto const key = s.key.load(std::memory_order_relaxed);
+      if (key == hash) {
+        s.value.store(static_cast<std::int8_t>(lvl + 1), std::memory_order_relaxed);
+        update_max();
+        return true;
+      }
+      if (key == 0) {
+        if (lvl < 0)
+          return true;
+        if (count_.load(std::memory_order_relaxed) == CONFIG_LG_TAG_LEVELS)
+          return false;
+        s.value.store(static_cast<std::int8_t>(lvl + 1), std::memory_order_relaxed);
+        std::memcpy(s.name, tag.data(), tag.size());
+        s.name[tag.size()] = '\0';
+        s.key.store(hash, std::memory_order_release);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        update_max();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void set_default(int lvl) noexcept {
+    guard g(lock_);
+    default_.store(lvl, std::memory_order_relaxed);
+    update_max();
+  }
+
+  [[nodiscard]] int
+  default_level() const noexcept {
+    return default_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Calls 'func(name, level)' for each tag not at the default
+   */
+  template<typename Func>
+  void for_each(Func&& func) noexcept {
+    guard g(lock_);
+    for (auto const& s : slots_) {
+      if (s.key.load(std::memory_order_relaxed) == 0)
+        continue;
+      auto const value = s.value.load(std::memory_order_relaxed);
+      if (value != 0)
+        func(std::string_view(s.name), value - 1);
+    }
+  }
+
+  /**
+   * Removes all tags (back to the default). A concurrent lookup may see
+   * the default level before.
+   */
+  void reset() noexcept {
+    guard g(lock_);
+    for (auto& s : slots_) {
+      s.value.store(0, std::memory_order_relaxed);
+      s.key.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    update_max();
+  }
+
+ private:
+  struct slot {
+    std::atomic<std::uint32_t>  key{0};
+    std::atomic<std::int8_t>    value{0};     // level + 1, 0: default
+    char                        name[CONFIG_LG_TAG_SIZE + 1]{};
+  };
+
+  class guard {
+   public:
+    guard(std::atomic_flag& flag) noexcept
+     : flag_(flag) {
+      while (!try_lock())
+        vTaskDelay(1);
+    }
+    ~guard() noexcept {
+      flag_.clear(std::memory_order_release);
+    }
+   private:
+    static constexpr const int tries = 64;
+
+    bool try_lock() noexcept {
+      for (int i = 0; i < tries; ++i)
+        if (!flag_.test_and_set(std::memory_order_acquire))
+          return true;
+      return false;
+    }
+
+    std::atomic_flag& flag_;
+  };
+
+  void update_max() noexcept {
+    int max = default_.load(std::memory_order_relaxed);
+    for (auto const& s : slots_)
+      max = std::max(max, s.value.load(std::memory_order_relaxed) - 1);
+    max_.store(max, std::memory_order_relaxed);
+  }
+
+  std::array<slot, capacity>  slots_{};
+  std::atomic<int>            default_{static_cast<int>(level::verbose)};
+  std::atomic<int>            max_{static_cast<int>(level::verbose)};
+  std::atomic<std::size_t>    count_{0};
+  std::atomic_flag            lock_ = ATOMIC_FLAG_INIT;
+};
+
+inline level_table levels;
+
+[[nodiscard]] constexpr int
+parse_level(std::string_view str) noexcept {
+  if (str.size() != 1)
+    return -1;
+  switch (str[0]) {
+    case 'N': case 'n': case '0': return 0;
+    case 'E': case 'e': case '1': return 1;
+    case 'W': case 'w': case '2': return 2;
+    case 'I': case 'i': case '3': return 3;
+    case 'D': case 'd': case '4': return 4;
+    case 'V': case 'v': case '5': return 5;
+  }
+  return -1;
+}
+
+[[nodiscard]] constexpr std::string_view
+trim(std::string_view str) noexcept {
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\n' || str.front() == '\r'))
+    str.remove_prefix(1);
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\n' || str.back() == '\r'))
+    str.remove_suffix(1);
+  return str;
+}
+
+/**
+ * Calls 'func(tag, level)' for each "tag:level" of 'spec' ('*': default).
+ * False at the first invalid entry.
+ */
+template<typename Func>
+constexpr bool
+for_each_level(std::string_view spec, Func&& func) noexcept {
+  while (!spec.empty()) {
+    auto const end = spec.find(',');
+    auto const entry = trim(spec.substr(0, end));
+    spec = end == std::string_view::npos ? std::string_view{} : spec.substr(end + 1);
+    if (entry.empty())
+      continue;
+
+    auto const sep = entry.rfind(':');
+    if (sep == std::string_view::npos)
+      return false;
+    auto const tag = trim(entry.substr(0, sep));
+    int const lvl = parse_level(trim(entry.substr(sep + 1)));
+    if (tag.empty() || tag.size() > CONFIG_LG_TAG_SIZE || lvl < 0)
+      return false;
+    func(tag, lvl);
+  }
+  return true;
+}
+
+}  // namespace detail
+
+/**
+ * If a record of 'lvl' of 'tag' is shown
+ */
+[[nodiscard]] inline bool
+enabled(int lvl, const tag_view& tag) noexcept {
+  return detail::levels.enabled(lvl, tag);
+}
+
+inline bool
+set_level(std::string_view tag, level lvl) noexcept {
+  return detail::levels.set(tag, static_cast<int>(lvl));
+}
+
+/**
+ * Tag back to the default level
+ */
+inline void
+reset_level(std::string_view tag) noexcept {
+  detail::levels.set(tag, -1);
+}
+
+inline void
+reset_levels() noexcept {
+  detail::levels.reset();
+}
+
+inline void
+set_default_level(level lvl) noexcept {
+  detail::levels.set_default(static_cast<int>(lvl));
+}
+
+[[nodiscard]] inline level
+get_level(const tag_view& tag) noexcept {
+  return static_cast<level>(detail::levels.get(tag.hash()));
+}
+
+[[nodiscard]] inline level
+get_default_level() noexcept {
+  return static_cast<level>(detail::levels.default_level());
+}
+
+/**
+ * Applies "tag:level,..." (level as letter N/E/W/I/D/V or 0-5, tag '*' as
+ * the default). Nothing is applied if any entry is invalid. False if
+ * invalid or the table is full.
+ */
+inline bool
+apply_levels(std::string_view spec) noexcept {
+  if (!detail::for_each_level(spec, [](std::string_view, int) {}))
+    return false;
+  bool ok = true;
+  detail::for_each_level(spec, [&ok](std::string_view tag, int lvl) {
+    if (tag == "*")
+      detail::levels.set_default(lvl);
+    else
+      ok = detail::levels.set(tag, lvl) && ok;
+  });
+  return ok;
+}
+
+/**
+ * Writes the levels as "*:default,tag:level,..." (as apply_levels()),
+ * null terminated. Returns the size written (without the null), 0 if
+ * 'size' is too small.
+ */
+inline std::size_t
+format_levels(char* buffer, std::size_t size) noexcept {
+  static constexpr const char letters[] = "NEWIDV";
+  std::size_t used = 0;
+  bool fit = true;
+  auto append = [&](std::string_view tag, int lvl) {
+    std::size_t const need = (used ? 1 : 0) + tag.size() + 2;
+    if (used + need + 1 > size) {
+      fit = false;
+      return;
+    }
+    if (used)
+      buffer[used++] = ',';
+    std::memcpy(buffer + used, tag.data(), tag.size());
+    used += tag.size();
+    buffer[used++] = ':';
+    buffer[used++] = letters[lvl];
+  };
+
+  append("*", detail::levels.default_level());
+  detail::levels.for_each(append);
+  if (!fit)
+    return 0;
+  buffer[used] = '\0';
+  return used;
+}
+
+}  // namespace lg
+
+#endif  // COMPONENTS_LG_LEVELS_HPP_
@@ -27,7 +27,18 @@ name(fmt::format_string<Ts...> fmt,               \
   lg::name<Config, Ts...>(tag_,                   \
                           fmt,                    \
                           std::forward<Ts>(args)...);  \
-} 
+}                                                 \
+                                                  \
+template<typename Config = config_type,           \
+         fixed_string Format,                     \
+         typename ...Ts>                          \
+constexpr void                                    \
+name(format_literal<Format> fmt,                  \
+      Ts&&... args) const {                       \
+  lg::name<Config>(tag_,                          \
+                   fmt,                           \
+                   std::forward<Ts>(args)...);    \
+}
 
 template<typename ClassConfig = default_config>
 class log {
@@ -36,7 +47,7 @@ class log {
 
   constexpr
   log(std::string_view tag)
-   : tag_(tag) {}
+   : tag_(tag_view(tag).hashed()) {}
   
   LOG_METHOD_MAKE(verbose)
   LOG_METHOD_MAKE(debug)
@@ -46,10 +57,10 @@ class log {
 
   [[nodiscard]] constexpr std::string_view
   tag() const noexcept {
-    return tag_;
+    return tag_.name();
   }
  private:
-  std::string_view tag_;
+  tag_view tag_;
 };
 
 }  // namespace lg
@@ -0,0 +1,283 @@
+/**
+ * @file sink.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Where the formatted records are written: stdout (UART), RAM ring,
+ *        retained (RTC memory) ring, or many of them
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * static lg::ring_storage<4096> ram_log;
+ * using ram = lg::config<true, false, lg::timestamp, false, lg::ring_sink<ram_log>>;
+ * lg::info<ram>("ADC", "{} samples", size);
+ *
+ * // Last records before a reset (one translation unit)
+ * RTC_NOINIT_ATTR lg::ring_storage<2048> crash_log;
+ * using crash = lg::ring_sink<crash_log>;
+ * using console = lg::config<true, true, lg::timestamp, false,
+ *                            lg::tee_sink<lg::stdout_sink, crash>>;
+ *
+ * // At boot, before logging to it
+ * if (crash::recover()) {
+ *   char buffer[256];
+ *   while (auto size = crash::read(buffer, sizeof(buffer)))
+ *     lg::write(buffer, size);
+ * }
+ *
+ * A sink is a type with static functions: 'write(data, size)' (one whole
+ * record, false if dropped) and 'stats()'. See websocket/log_sink.hpp
+ * for a sink to websocket clients.
+ */
+#ifndef COMPONENTS_LG_SINK_HPP_
+#define COMPONENTS_LG_SINK_HPP_
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <type_traits>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace lg {
+
+struct sink_statistics {
+  std::uint32_t written;      // Records
+  std::uint32_t dropped;      // Records
+};
+
+template<typename Sink>
+concept sink = requires(const char* data, std::size_t size) {
+  { Sink::write(data, size) } noexcept -> std::same_as<bool>;
+  { Sink::stats() } -> std::same_as<sink_statistics>;
+};
+
+/**
+ * Written/dropped counters of a sink
+ */
+class sink_counters {
+ public:
+  bool count(bool written) noexcept {
+    (written ? written_ : dropped_).fetch_add(1, std::memory_order_relaxed);
+    return written;
+  }
+
+  [[nodiscard]] sink_statistics
+  stats() const noexcept {
+    return {
+      written_.load(std::memory_order_relaxed),
+      dropped_.load(std::memory_order_relaxed)
+    };
+  }
+
+ private:
+  std::atomic<std::uint32_t> written_{0};
+  std::atomic<std::uint32_t> dropped_{0};
+};
+
+/**
+ * The default: stdout, the UART console. The caller waits the UART
+ * driver, as ESP_LOG does.
+ */
+struct stdout_sink {
+  static bool
+  write(const char* data, std::size_t size) noexcept {
+    return counters_.count(std::fwrite(data, 1, size, stdout) == size);
+  }
+
+  [[nodiscard]] static sink_statistics
+  stats() noexcept {
+    return counters_.stats();
+  }
+
+ private:
+  static inline sink_counters counters_;
+};
+
+/**
+ * Memory of a ring_sink. Plain data, so it can be placed at memory not
+ * initialized at reset (RTC_NOINIT_ATTR); zero initialized it is a empty
+ * ring.
+ */
+template<std::size_t Size>
+struct ring_storage {
+  static_assert(Size >= 64 && (Size & (Size - 1)) == 0,
+                "Size must be a power of 2, at least 64");
+  static constexpr const std::size_t size = Size;
+  static constexpr const std::uint32_t magic_value = 0x6C67524E;   // "lgRN"
+
+  std::uint32_t magic;
+  std::uint32_t head;           // Bytes written
+  std::uint32_t tail;           // Bytes read or overwritten
+  std::uint32_t overwritten;    // Bytes overwritten before read
+  char          data[Size];
+};
+
+/**
+ * Byte ring that keeps the last bytes written: a new record overwrites
+ * the oldest not read ones (counted at lost()). The caller never waits:
+ * if the ring is busy (other writer or a read) after a few tries, or the
+ * record is bigger than the ring, it is dropped. The cost is a copy of
+ * the record.
+ *
+ * The first record read after a overwrite may be incomplete.
+ */
+template<auto& Storage>
+class ring_sink {
+ public:
+  using storage_type = std::remove_cvref_t<decltype(Storage)>;
+  static constexpr const std::size_t size = storage_type::size;
+
+  static bool
+  write(const char* data, std::size_t length) noexcept {
+    if (length > size || !try_lock())
+      return counters_.count(false);
+
+    auto& s = Storage;
+    std::uint32_t const used = s.head - s.tail;
+    if (used + length > size) {
+      std::uint32_t const over = used + length - size;
+      s.tail += over;
+      s.overwritten += over;
+    }
+    copy_in(s.head & mask, data, length);
+    s.head += length;
+    unlock();
+    return counters_.count(true);
+  }
+
+  /**
+   * Moves the oldest bytes to 'buffer'. Returns the size read (0: empty).
+   */
+  static std::size_t
+  read(char* buffer, std::size_t length) noexcept {
+    lock();
+    auto& s = Storage;
+    std::size_t const n = std::min<std::size_t>(length, s.head - s.tail);
+    std::size_t const offset = s.tail & mask;
+    std::size_t const first = std::min(n, size - offset);
+    std::memcpy(buffer, s.data + offset, first);
+    std::memcpy(buffer + first, s.data, n - first);
+    s.tail += n;
+    unlock();
+    return n;
+  }
+
+  /**
+   * Bytes not read
+   */
+  [[nodiscard]] static std::size_t
+  pending() noexcept {
+    lock();
+    std::size_t const n = Storage.head - Storage.tail;
+    unlock();
+    return n;
+  }
+
+  /**
+   * Bytes overwritten before read
+   */
+  [[nodiscard]] static std::uint32_t
+  lost() noexcept {
+    return Storage.overwritten;
+  }
+
+  /**
+   * To be called at boot, before any write, for a storage not initialized
+   * at reset. Returns true if it holds the ring of before the reset (kept
+   * to be read), else it is cleared.
+   */
+  static bool
+  recover() noexcept {
+    lock();
+    auto& s = Storage;
+    bool const valid = s.magic == storage_type::magic_value &&
+                       s.head - s.tail <= size;
+    if (!valid) {
+      s.head = 0;
+      s.tail = 0;
+      s.overwritten = 0;
+      s.magic = storage_type::magic_value;
+    }
+    unlock();
+    return valid;
+  }
+
+  static void
+  clear() noexcept {
+    lock();
+    Storage.tail = Storage.head;
+    Storage.overwritten = 0;
+    unlock();
+  }
+
+  [[nodiscard]] static sink_statistics
+  stats() noexcept {
+    return counters_.stats();
+  }
+
+ private:
+  static constexpr const std::uint32_t mask = size - 1;
+  static constexpr const int tries = 64;
+
+  static void
+  copy_in(std::size_t offset, const char* data, std::size_t length) noexcept {
+    std::size_t const first = std::min(length, size - offset);
+    std::memcpy(Storage.data + offset, data, first);
+    std::memcpy(Storage.data, data + first, length - first);
+  }
+
+  /**
+   * The lock is not at the storage: atomics may not work at RTC memory
+   */
+  static bool
+  try_lock() noexcept {
+    for (int i = 0; i < tries; ++i)
+      if (!lock_.test_and_set(std::memory_order_acquire))
+        return true;
+    return false;
+  }
+
+  static void
+  lock() noexcept {
+    while (!try_lock())
+      vTaskDelay(1);
+  }
+
+  static void
+  unlock() noexcept {
+    lock_.clear(std::memory_order_release);
+  }
+
+  static inline std::atomic_flag  lock_ = ATOMIC_FLAG_INIT;
+  static inline sink_counters     counters_;
+};
+
+/**
+ * Writes to all 'Sinks'. Dropped: records dropped by any of them.
+ */
+template<typename ...Sinks>
+struct tee_sink {
+  static bool
+  write(const char* data, std::size_t size) noexcept {
+    return counters_.count((Sinks::write(data, size) & ...));
+  }
+
+  [[nodiscard]] static sink_statistics
+  stats() noexcept {
+    return counters_.stats();
+  }
+
+ private:
+  static inline sink_counters counters_;
+};
+
+}  // namespace lg
+
+#endif  // COMPONENTS_LG_SINK_HPP_
@@ -0,0 +1,355 @@
+/**
+ * @file strip.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Format strings replaced by ids: binary records, decoded at the host
+ *        with the ELF file (scripts/lg_decode.py)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * using namespace lg::literals;
+ *
+ * lg::info("ADC", "{} samples, rms {:.3f}"_lg, size, rms);
+ * lg::log ll{"ADC"};
+ * ll.warn("overflow at {}"_lg, seq);
+ *
+ * $ python scripts/lg_decode.py build/app.elf capture.bin
+ *
+ * With CONFIG_LG_STRIP_FORMAT, "..."_lg format strings are not kept at
+ * the firmware: each one (with the argument types) is written to the
+ * '.lg_fmt' section, not loaded to the device, and the record carries
+ * only its 32 bits id:
+ *
+ * 0x1E | size (u8, bytes after it) | id (u32) | time (u32) | level letter |
+ * tag size (u8) | tag | arguments
+ *
+ * All little endian. Arguments are written as the signature character of
+ * its type (python struct codes): '?' bool, 'c' char, 'b' 'h' 'i' 'q' and
+ * 'B' 'H' 'I' 'Q' integers (enums as its underlying type), 'f' float,
+ * 'd' double; 's' strings, as size (u8) and characters. Strings (and
+ * tag) are truncated to fit CONFIG_LG_BUFFER_SIZE (at most 257 bytes).
+ *
+ * A '.lg_fmt' entry is 0x01 | signature | 0x00 | format | 0x00 (padded with
+ * 0x00 to a multiple of 8). The id is the 32 bits FNV-1a of
+ * "signature\0format".
+ *
+ * Formats with arguments of other types, or configs with a not integer
+ * time, are formatted as text (the format string is kept). Without
+ * CONFIG_LG_STRIP_FORMAT "..."_lg formats are always text.
+ *
+ * Deferred configs (lg/deferred.hpp) store the arguments, and the drain
+ * task writes the binary record: the id is part of the decoder, no format
+ * string is referenced.
+ */
+#ifndef COMPONENTS_LG_STRIP_HPP_
+#define COMPONENTS_LG_STRIP_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "lg/core.hpp"
+#include "lg/args.hpp"
+
+namespace lg {
+
+template<std::size_t N>
+struct fixed_string {
+  char data[N]{};
+
+  consteval
+  fixed_string(const char (&str)[N]) noexcept {
+    std::copy_n(str, N, data);
+  }
+
+  [[nodiscard]] constexpr std::string_view
+  view() const noexcept {
+    return {data, N - 1};
+  }
+};
+
+/**
+ * Format string as a type, so it can be stripped
+ */
+template<fixed_string Format>
+struct format_literal {
+  static constexpr std::string_view value = Format.view();
+};
+
+namespace literals {
+
+template<fixed_string Format>
+consteval format_literal<Format>
+operator ""_lg() noexcept {
+  return {};
+}
+
+}  // namespace literals
+
+namespace detail {
+
+inline constexpr std::uint8_t strip_frame = 0x1E;
+inline constexpr std::uint8_t strip_entry = 0x01;
+inline constexpr std::size_t strip_max_size = std::min<std::size_t>(
+                                                CONFIG_LG_BUFFER_SIZE, 257);
+
+consteval std::uint32_t
+fnv1a(const char* data, std::size_t size) noexcept {
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<std::uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template<typename T>
+consteval char
+integer_code() noexcept {
+  constexpr const char* codes = std::is_signed_v<T> ? "bhiq" : "BHIQ";
+  return codes[std::bit_width(sizeof(T)) - 1];
+}
+
+/**
+ * 0: not strippable
+ */
+template<typename T>
+consteval char
+type_code() noexcept {
+  using type = arg_type<T>;
+  if constexpr (is_string_arg_v<T>)
+    return 's';
+  else if constexpr (std::is_same_v<type, bool>)
+    return '?';
+  else if constexpr (std::is_same_v<type, char>)
+    return 'c';
+  else if constexpr (std::is_enum_v<type>)
+    return integer_code<std::underlying_type_t<type>>();
+  else if constexpr (std::is_integral_v<type> && sizeof(type) <= 8)
+    return integer_code<type>();
+  else if constexpr (std::is_same_v<type, float>)
+    return 'f';
+  else if constexpr (std::is_same_v<type, double>)
+    return 'd';
+  else
+    return 0;
+}
+
+template<typename T>
+inline constexpr bool is_strippable_v = type_code<T>() != 0;
+
+#ifdef CONFIG_LG_STRIP_FORMAT
+inline constexpr bool strip_format = true;
+#else
+inline constexpr bool strip_format = false;
+#endif
+
+template<typename Config, typename ...T>
+inline constexpr bool strippable =
+  strip_format &&
+  (is_strippable_v<T> && ...) &&
+  std::is_integral_v<decltype(Config::time::time())>;
+
+/**
+ * Checks the arguments as any format string, without referencing it at
+ * runtime
+ */
+template<fixed_string Format, typename ...T>
+consteval void
+check_format() noexcept {
+  [[maybe_unused]] fmt::format_string<T...> const fmt(Format.view());
+}
+
+/**
+ * The '.lg_fmt' entry of a format/argument types
+ */
+template<fixed_string Format, typename ...T>
+struct format_entry {
+  static constexpr std::size_t used = 1 + sizeof...(T) + 1 + Format.view().size() + 1;
+  static constexpr std::size_t size = (used + 7) / 8 * 8;
+
+  static constexpr std::array<char, size> value = [] {
+    std::array<char, size> entry{};
+    std::size_t i = 0;
+    entry[i++] = strip_entry;
+    ((entry[i++] = type_code<T>()), ...);
+    entry[i++] = '\0';
+    for (char c : Format.view())
+      entry[i++] = c;
+    return entry;
+  }();
+
+  static constexpr std::uint32_t id = fnv1a(value.data() + 1, used - 2);
+};
+
+template<unsigned char C0, unsigned char C1, unsigned char C2, unsigned char C3,
+         unsigned char C4, unsigned char C5, unsigned char C6, unsigned char C7>
+[[gnu::always_inline]] inline void
+emit_bytes() noexcept {
+  asm volatile(".pushsection .lg_fmt,\"\",@progbits\n\t"
+               ".byte %c0,%c1,%c2,%c3,%c4,%c5,%c6,%c7\n\t"
+               ".popsection"
+               :: "i"(C0), "i"(C1), "i"(C2), "i"(C3),
+                  "i"(C4), "i"(C5), "i"(C6), "i"(C7));
+}
+
+/**
+ * Writes the entry to the (not allocated) '.lg_fmt' section. No code is
+ * generated; inlined copies only repeat the entry at the ELF file.
+ */
+template<typename Entry>
+[[gnu::always_inline]] inline void
+emit_entry() noexcept {
+  constexpr auto byte = [](std::size_t i) {
+    return static_cast<unsigned char>(Entry::value[i]);
+  };
+  [&]<std::size_t ...I>(std::index_sequence<I...>) {
+    (emit_bytes<byte(I * 8),     byte(I * 8 + 1), byte(I * 8 + 2), byte(I * 8 + 3),
+                byte(I * 8 + 4), byte(I * 8 + 5), byte(I * 8 + 6), byte(I * 8 + 7)>(), ...);
+  }(std::make_index_sequence<Entry::size / 8>{});
+}
+
+/**
+ * Bounded writer of a binary record
+ */
+class binary_record {
+ public:
+  constexpr
+  binary_record(std::uint8_t* buffer, std::size_t size) noexcept
+   : buffer_(buffer), size_(size) {}
+
+  template<typename T>
+  void put(const T& value) noexcept {
+    std::memcpy(buffer_ + used_, &value, sizeof(T));
+    used_ += sizeof(T);
+  }
+
+  /**
+   * Size (u8) and characters, truncated to keep 'reserve' bytes free
+   */
+  void put_string(std::string_view str, std::size_t reserve) noexcept {
+    std::size_t const size = std::min({str.size(),
+                                       std::size_t{255},
+                                       size_ - used_ - reserve - 1});
+    put(static_cast<std::uint8_t>(size));
+    std::memcpy(buffer_ + used_, str.data(), size);
+    used_ += size;
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  size() const noexcept {
+    return used_;
+  }
+
+ private:
+  std::uint8_t* buffer_;
+  std::size_t   size_;
+  std::size_t   used_ = 0;
+};
+
+template<typename T>
+constexpr std::size_t
+fixed_size() noexcept {
+  return is_string_arg_v<T> ? 1 : sizeof(arg_type<T>);
+}
+
+template<typename T>
+void
+put_arg(binary_record& rec, const T& arg, std::size_t& reserve) noexcept {
+  reserve -= fixed_size<T>();
+  if constexpr (is_string_arg_v<T>)
+    rec.put_string(as_string(arg), reserve);
+  else if constexpr (std::is_enum_v<T>)
+    rec.put(static_cast<std::underlying_type_t<T>>(arg));
+  else
+    rec.put(arg);
+}
+
+template<typename Level,
+         typename Config,
+         typename Entry,
+         typename ...T>
+void
+write_stripped(std::uint32_t time, std::string_view tag, const T& ...args) noexcept {
+  static_assert(std::endian::native == std::endian::little);
+
+  // Frame, size, id, time, level, tag size
+  constexpr std::size_t header_size = 1 + 1 + 4 + 4 + 1 + 1;
+  constexpr std::size_t args_size = (fixed_size<T>() + ... + 0);
+  static_assert(header_size + args_size <= strip_max_size,
+                "Too many arguments to strip");
+
+  emit_entry<Entry>();
+
+  std::uint8_t buffer[strip_max_size];
+  // Bytes of the fixed size fields after the tag
+  std::size_t reserve = args_size;
+
+  binary_record rec(buffer, sizeof(buffer));
+  rec.put(strip_frame);
+  rec.put(std::uint8_t{0});
+  rec.put(Entry::id);
+  rec.put(time);
+  rec.put(Level::letter);
+  rec.put_string(tag, reserve);
+  (put_arg(rec, args, reserve), ...);
+
+  buffer[1] = static_cast<std::uint8_t>(rec.size() - 2);
+  Config::sink::write(reinterpret_cast<const char*>(buffer), rec.size());
+}
+
+/**
+ * Writer of the deferred records (basic_deferred::push_writer)
+ */
+template<typename Level,
+         typename Config,
+         typename Entry>
+struct stripped_writer {
+  template<typename ...T>
+  static void
+  write(std::uint32_t time, std::string_view tag, const T& ...args) noexcept {
+    write_stripped<Level, Config, Entry>(time, tag, args...);
+  }
+};
+
+}  // namespace detail
+
+template<typename Level,
+         typename Config = default_config,
+         fixed_string Format,
+         typename ...T>
+constexpr void
+out(tag_view tag,
+    format_literal<Format>,
+    T&& ...args) {
+  if constexpr (detail::strippable<Config, T...>) {
+    detail::check_format<Format, T...>();
+    if constexpr (Config::force || Level::level <= LOG_LOCAL_LEVEL) {
+      if constexpr (!Config::force)
+        if (!enabled(Level::level, tag))
+          return;
+      using entry = detail::format_entry<Format, T...>;
+      if constexpr (detail::deferred_config<Config>)
+        Config::deferred::template push_writer<
+            detail::stripped_writer<Level, Config, entry>, Config>(tag.name(), args...);
+      else
+        detail::write_stripped<Level, Config, entry>(
+            static_cast<std::uint32_t>(Config::time::time()), tag.name(), args...);
+    }
+  } else
+    out<Level, Config>(tag,
+                       fmt::format_string<T...>(Format.view()),
+                       std::forward<T>(args)...);
+}
+
+}  // namespace lg
+
+#endif  // COMPONENTS_LG_STRIP_HPP_
@@ -0,0 +1,194 @@
+/**
+ * @file deferred.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Deferred logging: output equal to the eager path, fallbacks,
+ *        drops, concurrent producers and caller cost
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * lg_deferred [--quick]
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lg/level.hpp"
+#include "lg/log.hpp"
+#include "lg/deferred.hpp"
+
+#include "harness.hpp"
+#include "output.hpp"
+
+using harness::check;
+using lg_test::capture;
+using lg_test::fixed_time;
+
+using ring = lg::basic_deferred<16, 64>;
+using deferred = lg::deferred_config<ring, true, true, fixed_time>;
+using eager = lg::config<true, true, fixed_time>;
+
+/**
+ * Not a deferrable type: formatted by the caller
+ */
+struct point {
+  int x, y;
+};
+
+template<>
+struct fmt::formatter<point> {
+  constexpr auto
+  parse(fmt::format_parse_context& ctx) -> fmt::format_parse_context::iterator {
+    return ctx.end();
+  }
+
+  auto format(const point& p, fmt::format_context& ctx) const -> fmt::format_context::iterator {
+    return fmt::format_to(ctx.out(), "({}, {})", p.x, p.y);
+  }
+};
+
+enum class state : int { idle = 1 };
+
+template<typename Config>
+static void
+records() {
+  char name[] = "stack";
+  std::string owned = "owned";
+  lg::info<Config>("ADC", "{} samples, rms {:.3f}, {}", 1024, 1.2345, true);
+  lg::warn<Config>("TAG", "{} {} {} {}", name, owned, std::string_view("view"), 'c');
+  lg::error<Config>("TAG", "{:>6}|{:x}|{}", -12, 255u, static_cast<int>(state::idle));
+  lg::log<Config>("Class").info("no arguments");
+  std::strcpy(name, "XXXXX");     // Already copied
+  owned = "changed";
+}
+
+static void
+output() {
+  auto const expected = capture(records<eager>);
+  auto const at_call = capture(records<deferred>);
+  auto const written = capture([] { ring::drain(); });
+
+  check("nothing written at the call", at_call.empty());
+  check("same output as eager", written == expected && !expected.empty());
+  check("stats deferred", ring::stats().deferred == 4 && ring::stats().eager == 0);
+
+  // Eager fallbacks: unknown type and record too big
+  auto const fallback = capture([] {
+    lg::info<deferred>("TAG", "{}", point{1, 2});
+    lg::info<deferred>("TAG", "{}", std::string(100, 'x'));
+  });
+  check("fallback written at the call",
+        fallback == capture([] {
+          lg::info<eager>("TAG", "{}", point{1, 2});
+          lg::info<eager>("TAG", "{}", std::string(100, 'x'));
+        }));
+  check("stats eager", ring::stats().eager == 2);
+  check("nothing deferred", capture([] { ring::drain(); }).empty());
+
+  // Full ring
+  for (int i = 0; i < 20; ++i)
+    lg::info<deferred>("TAG", "{}", i);
+  auto const full = capture([] { ring::drain(); });
+  check("full ring dropped", ring::stats().dropped == 4);
+  check("full ring warning", full.find("4 records dropped") != std::string::npos);
+  check("full ring kept", full.find(":15") != std::string::npos &&
+                          full.find(":16") == std::string::npos);
+}
+
+static void
+producers() {
+  using big = lg::basic_deferred<1024, 64>;
+  using config = lg::deferred_config<big, true, false, fixed_time>;
+  constexpr const int threads = 4, per_thread = 2000;
+
+  auto const out = capture([] {
+    big::start(1, 0, tskNO_AFFINITY, 1);
+    std::vector<std::thread> ths;
+    for (int t = 0; t < threads; ++t)
+      ths.emplace_back([t] {
+        for (int i = 0; i < per_thread; ++i) {
+          lg::info<config>("T", "{} {}", t, i);
+          if (i % 128 == 127)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+      });
+    for (auto& th : ths)
+      th.join();
+    big::stop();
+  });
+
+  auto const stats = big::stats();
+  check("producers all accounted",
+        stats.deferred + stats.dropped == threads * per_thread);
+
+  // Each record written once, each thread's records in order
+  std::size_t lines = 0;
+  bool ordered = true;
+  int last[threads] = {-1, -1, -1, -1};
+  std::size_t pos = 0;
+  while ((pos = out.find("T:", pos)) != std::string::npos) {
+    int t, i;
+    if (std::sscanf(out.c_str() + pos, "T:%d %d", &t, &i) == 2) {
+      ordered = ordered && i > last[t];
+      last[t] = i;
+      ++lines;
+    }
+    pos += 2;
+  }
+  check("producers written", lines == stats.deferred);
+  check("producers order", ordered);
+  std::printf("producers: %u deferred, %u dropped\n", stats.deferred, stats.dropped);
+}
+
+/**
+ * Caller cost only: the drain (formatting and write) runs out of the
+ * timed section, as at the drain task
+ */
+static void
+benchmark(double min_time) {
+  using bench = lg::basic_deferred<512, 64>;
+  using config = lg::deferred_config<bench, true, true, fixed_time>;
+  using clock = std::chrono::steady_clock;
+  static constexpr const int batch = 512;
+
+  double deferred_ns = 0, eager_ns = 0;
+  lg_test::redirect("/dev/null", [&] {
+    std::chrono::duration<double> elapsed{};
+    std::size_t records = 0;
+    do {
+      auto const start = clock::now();
+      for (int i = 0; i < batch; ++i)
+        lg::info<config>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                         1024, 1.2345, 59.98);
+      elapsed += clock::now() - start;
+      records += batch;
+      bench::drain();
+    } while (elapsed.count() < min_time);
+    deferred_ns = elapsed.count() * 1e9 / static_cast<double>(records);
+
+    eager_ns = harness::ns_per_sample(batch, [] {
+      for (int i = 0; i < batch; ++i)
+        lg::info<eager>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                        1024, 1.2345, 59.98);
+    }, min_time);
+  });
+
+  check("benchmark nothing dropped", bench::stats().dropped == 0);
+  std::printf("\ncaller cost: deferred %.1f ns/record, eager %.1f ns/record\n",
+              deferred_ns, eager_ns);
+}
+
+int main(int argc, char** argv) {
+  bool const quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+  output();
+  producers();
+  benchmark(quick ? 0.02 : 0.5);
+
+  return harness::result();
+}
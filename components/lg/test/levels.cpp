@@ -0,0 +1,258 @@
+/**
+ * @file levels.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Runtime levels per tag: filtering, parsing and cost of a disabled
+ *        record
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * lg_levels [--quick]
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lg/level.hpp"
+#include "lg/log.hpp"
+#include "lg/levels.hpp"
+#include "lg/deferred.hpp"
+
+#include "harness.hpp"
+#include "output.hpp"
+
+using harness::check;
+using lg_test::capture;
+using lg_test::fixed_time;
+
+using no_color = lg::config<true, false, fixed_time>;
+using forced = lg::config<true, false, fixed_time, true>;
+
+using ring = lg::basic_deferred<16, 64>;
+using deferred = lg::deferred_config<ring, true, false, fixed_time>;
+
+/**
+ * Counts how many times it was formatted
+ */
+struct counted {
+  static inline int formatted = 0;
+};
+
+template<>
+struct fmt::formatter<counted> {
+  constexpr auto
+  parse(fmt::format_parse_context& ctx) -> fmt::format_parse_context::iterator {
+    return ctx.end();
+  }
+
+  auto format(const counted&, fmt::format_context& ctx) const -> fmt::format_context::iterator {
+    ++counted::formatted;
+    return fmt::format_to(ctx.out(), "counted");
+  }
+};
+
+// String literals hashed at compile time
+static_assert(lg::tag_view("ADC").hash() == lg::detail::tag_hash("ADC"));
+
+static bool
+shown(auto&& func) {
+  return !capture(func).empty();
+}
+
+static void
+filter() {
+  lg::log<no_color> adc("ADC");
+
+  check("default shown", shown([] { lg::info<no_color>("ADC", "{}", 1); }));
+  check("compile time filter", !shown([] { lg::debug<no_color>("ADC", "{}", 1); }));
+
+  lg::set_level("ADC", lg::level::warn);
+  check("tag hidden", !shown([] { lg::info<no_color>("ADC", "{}", 1); }));
+  check("tag hidden (class)", !shown([&] { adc.info("{}", 1); }));
+  check("tag shown above", shown([&] { adc.warn("{}", 1); }));
+  check("other tag shown", shown([] { lg::info<no_color>("TAG", "{}", 1); }));
+  check("forced shown", shown([] { lg::info<forced>("ADC", "{}", 1); }));
+  check("get level", lg::get_level("ADC") == lg::level::warn &&
+                     lg::get_level("TAG") == lg::level::verbose);
+
+  lg::set_default_level(lg::level::none);
+  lg::set_level("ADC", lg::level::info);
+  check("default none", !shown([] { lg::error<no_color>("TAG", "{}", 1); }));
+  check("tag above default", shown([&] { adc.info("{}", 1); }));
+
+  // Nothing formatted or stored
+  counted::formatted = 0;
+  lg::set_level("ADC", lg::level::error);
+  capture([&] {
+    adc.info("{}", counted{});
+    lg::info<no_color>("TAG", "{}", counted{});
+    lg::info<deferred>("ADC", "{}", 1);
+  });
+  check("not formatted", counted::formatted == 0);
+  check("not deferred", ring::stats().deferred == 0 && ring::stats().eager == 0);
+
+  // Tags built at runtime: hashed at the lookup
+  char buffer[8] = "ADC";
+  std::string const name = "ADC";
+  check("runtime tags hidden", !shown([&] {
+    lg::info<no_color>(buffer, "{}", 1);
+    lg::info<no_color>(name, "{}", 1);
+    lg::info<no_color>(name.c_str(), "{}", 1);
+  }));
+  check("runtime tags shown above", shown([&] { lg::error<no_color>(buffer, "{}", 1); }) &&
+                                    shown([&] { lg::error<no_color>(name, "{}", 1); }));
+
+  lg::reset_level("ADC");
+  check("reset level", lg::get_level("ADC") == lg::level::none);
+  lg::set_default_level(lg::level::verbose);
+  lg::reset_levels();
+  check("reset all", shown([&] { adc.info("{}", 1); }));
+}
+
+static void
+parse() {
+  char buffer[lg::levels_string_size];
+
+  check("apply", lg::apply_levels(" *:W, wifi:D,adc:1 ,http:n,"));
+  check("applied", lg::get_default_level() == lg::level::warn &&
+                   lg::get_level("wifi") == lg::level::debug &&
+                   lg::get_level("adc") == lg::level::error &&
+                   lg::get_level("http") == lg::level::none &&
+                   lg::get_level("other") == lg::level::warn);
+
+  auto const size = lg::format_levels(buffer, sizeof(buffer));
+  std::string const saved(buffer, size);
+  check("format", saved.starts_with("*:W,") &&
+                  saved.find("wifi:D") != std::string::npos &&
+                  saved.find("adc:E") != std::string::npos &&
+                  saved.find("http:N") != std::string::npos &&
+                  saved.size() == std::strlen("*:W,wifi:D,adc:E,http:N"));
+  check("format small buffer", lg::format_levels(buffer, 8) == 0);
+
+  check("invalid level", !lg::apply_levels("*:I,wifi:X"));
+  check("invalid entry", !lg::apply_levels("*:I,wifi"));
+  check("invalid long tag", !lg::apply_levels(std::string(CONFIG_LG_TAG_SIZE + 1, 't') + ":I"));
+  check("nothing applied", lg::get_default_level() == lg::level::warn &&
+                           lg::get_level("wifi") == lg::level::debug);
+
+  // Round trip
+  lg::reset_levels();
+  lg::set_default_level(lg::level::verbose);
+  check("apply saved", lg::apply_levels(saved));
+  check("round trip", lg::format_levels(buffer, sizeof(buffer)) == saved.size() &&
+                      saved == buffer);
+
+  // Full table
+  lg::reset_levels();
+  bool all = true;
+  for (int i = 0; i < CONFIG_LG_TAG_LEVELS; ++i)
+    all = lg::set_level("tag" + std::to_string(i), lg::level::info) && all;
+  check("table fill", all);
+  check("table full", !lg::set_level("one_more", lg::level::info));
+  check("known tag when full", lg::set_level("tag0", lg::level::debug));
+
+  lg::reset_levels();
+  lg::set_default_level(lg::level::verbose);
+}
+
+static void
+concurrent() {
+  std::atomic<bool> run{true};
+  std::atomic<int> count{0};
+
+  lg_test::redirect("/dev/null", [&] {
+    std::vector<std::thread> ths;
+    for (int t = 0; t < 3; ++t)
+      ths.emplace_back([&, t] {
+        lg::log<no_color> ll(t == 0 ? "ADC" : "TAG");
+        while (run.load(std::memory_order_relaxed)) {
+          ll.info("{}", 1);
+          count.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    for (int i = 0; i < 2000 || count.load() < 10000; ++i) {
+      lg::set_level("ADC", i % 2 ? lg::level::info : lg::level::error);
+      lg::set_level("other" + std::to_string(i % 8), lg::level::warn);
+    }
+    lg::set_level("ADC", lg::level::error);
+    run.store(false);
+    for (auto& th : ths)
+      th.join();
+  });
+  check("concurrent", count.load() > 0 && lg::get_level("ADC") == lg::level::error);
+  lg::reset_levels();
+
+  // Writers contending for the table lock
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t)
+    writers.emplace_back([t] {
+      std::string const tag = "writer" + std::to_string(t);
+      for (int i = 0; i < 2000; ++i)
+        lg::set_level(tag, i % 2 ? lg::level::info : lg::level::debug);
+      lg::set_level(tag, t % 2 ? lg::level::warn : lg::level::error);
+    });
+  for (auto& th : writers)
+    th.join();
+  bool all = true;
+  for (int t = 0; t < 4; ++t)
+    all = all && lg::get_level("writer" + std::to_string(t)) ==
+                 (t % 2 ? lg::level::warn : lg::level::error);
+  check("concurrent writers", all);
+  lg::reset_levels();
+}
+
+static void
+benchmark(double min_time) {
+  lg::log<no_color> adc("ADC");
+  double hidden_max = 0, hidden_tag = 0, hidden_free = 0, shown_tag = 0;
+
+  lg_test::redirect("/dev/null", [&] {
+    // All levels below info: first compare only
+    lg::set_default_level(lg::level::warn);
+    hidden_max = harness::ns_per_sample(100, [&] {
+      for (int i = 0; i < 100; ++i)
+        adc.info("{} samples, rms {:.3f}", 1024, 1.2345);
+    }, min_time);
+
+    // Other tag at info: table lookup
+    lg::set_level("TAG", lg::level::info);
+    hidden_tag = harness::ns_per_sample(100, [&] {
+      for (int i = 0; i < 100; ++i)
+        adc.info("{} samples, rms {:.3f}", 1024, 1.2345);
+    }, min_time);
+
+    // Free function, literal tag: hashed at compile time
+    hidden_free = harness::ns_per_sample(100, [&] {
+      for (int i = 0; i < 100; ++i)
+        lg::info<no_color>("ADC", "{} samples, rms {:.3f}", 1024, 1.2345);
+    }, min_time);
+
+    lg::set_level("ADC", lg::level::info);
+    shown_tag = harness::ns_per_sample(100, [&] {
+      for (int i = 0; i < 100; ++i)
+        adc.info("{} samples, rms {:.3f}", 1024, 1.2345);
+    }, min_time);
+  });
+  lg::reset_levels();
+  lg::set_default_level(lg::level::verbose);
+
+  std::printf("\nhidden (level check) %.2f ns, hidden (tag lookup) %.2f ns, "
+              "hidden (free function lookup) %.2f ns, shown %.1f ns\n",
+              hidden_max, hidden_tag, hidden_free, shown_tag);
+}
+
+int main(int argc, char** argv) {
+  bool const quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+  filter();
+  parse();
+  concurrent();
+  benchmark(quick ? 0.02 : 0.5);
+
+  return harness::result();
+}
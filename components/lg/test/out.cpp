@@ -0,0 +1,178 @@
+/**
+ * @file out.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief lg::out output and cost: buffered record against the previous
+ *        per character path
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * lg_out [--quick]
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "lg/level.hpp"
+#include "lg/log.hpp"
+
+#include "harness.hpp"
+#include "output.hpp"
+
+using harness::check;
+using lg_test::capture;
+using lg_test::fixed_time;
+
+using color = lg::config<true, true, fixed_time>;
+using no_color = lg::config<true, false, fixed_time>;
+using no_break = lg::config<false, true, fixed_time>;
+
+/**
+ * lg::out before the record buffer: one lg::print (one fputc per
+ * character) for each part
+ */
+template<typename Level,
+         typename Config = lg::default_config,
+         typename ...T>
+void legacy_out(std::string_view tag,
+                fmt::format_string<T...> fmt,
+                T&& ...args) {
+  if constexpr (Config::force || Level::level <= LOG_LOCAL_LEVEL) {
+    if constexpr (Config::color)
+      lg::print("{}", Level::color);
+    lg::print("{} ({}) {}:",
+              Level::letter,
+              Config::time::time(),
+              tag);
+    lg::print(fmt,
+              std::forward<T>(args)...);
+    lg::print("{}", lg::end_color);
+    if constexpr (Config::break_line)
+      lg::print("\n");
+  }
+}
+
+static bool
+valid_utf8(std::string_view str) noexcept {
+  for (std::size_t i = 0; i < str.size();) {
+    auto const c = static_cast<unsigned char>(str[i]);
+    std::size_t const len = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : 4;
+    if (i + len > str.size())
+      return false;
+    for (std::size_t j = 1; j < len; ++j)
+      if ((static_cast<unsigned char>(str[i + j]) & 0xC0) != 0x80)
+        return false;
+    i += len;
+  }
+  return true;
+}
+
+template<typename Config>
+static void
+same_output(const char* name) {
+  auto const legacy = capture([] {
+    legacy_out<lg::info_level, Config>("ADC", "{} samples, rms {:.3f}", 1024, 1.2345);
+    legacy_out<lg::error_level, Config>("TAG", "no arguments");
+  });
+  auto const buffered = capture([] {
+    lg::info<Config>("ADC", "{} samples, rms {:.3f}", 1024, 1.2345);
+    lg::error<Config>("TAG", "no arguments");
+  });
+  check(name, legacy == buffered && !buffered.empty());
+}
+
+static void
+output() {
+  same_output<color>("same output (color)");
+  same_output<no_color>("same output (no color)");
+  same_output<no_break>("same output (no line break)");
+
+  check("level filtered", capture([] {
+    lg::verbose<color>("TAG", "not shown {}", 1);
+  }).empty());
+
+  check("log class", capture([] {
+    lg::log<no_color>("MyTag").warn("value {}", 7);
+  }) == "W (1234) MyTag:value 7" + std::string(lg::end_color) + "\n");
+
+  std::string const reset = std::string(lg::end_color) + "\n";
+  std::string const big(2 * CONFIG_LG_BUFFER_SIZE, 'x');
+  auto const truncated = capture([&] {
+    lg::info<color>("TAG", "{}", big);
+  });
+  check("truncated size", truncated.size() == CONFIG_LG_BUFFER_SIZE);
+  check("truncated tail", truncated.ends_with("..." + reset));
+
+  // 2 bytes characters: the cut must not split one
+  std::string utf8;
+  while (utf8.size() < 2 * CONFIG_LG_BUFFER_SIZE)
+    utf8 += "\xc3\xa7";   // ç
+  for (std::size_t pad = 0; pad < 2; ++pad) {
+    auto const out = capture([&] {
+      lg::info<no_color>("TAG", "{}{}", std::string(pad, 'p'), utf8);
+    });
+    char name[40];
+    std::snprintf(name, sizeof(name), "truncated utf-8 (pad %zu)", pad);
+    check(name, out.ends_with("..." + reset) &&
+                valid_utf8(std::string_view(out).substr(0, out.size() - 3 - reset.size())));
+  }
+}
+
+template<typename Func>
+static double
+ns_per_record(Func&& func, double min_time) {
+  double ns = 0;
+  lg_test::redirect("/dev/null", [&] {
+    ns = harness::ns_per_sample(100, [&] {
+      for (int i = 0; i < 100; ++i)
+        func();
+    }, min_time);
+  });
+  return ns;
+}
+
+static void
+benchmark(double min_time) {
+  struct row {
+    const char* name;
+    double      legacy;
+    double      buffered;
+  } const rows[] = {
+    {"short",
+     ns_per_record([] { legacy_out<lg::info_level, color>("TAG", "value {}", 42); }, min_time),
+     ns_per_record([] { lg::info<color>("TAG", "value {}", 42); }, min_time)},
+    {"typical",
+     ns_per_record([] {
+       legacy_out<lg::info_level, color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                                         1024, 1.2345, 59.98);
+     }, min_time),
+     ns_per_record([] {
+       lg::info<color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                       1024, 1.2345, 59.98);
+     }, min_time)},
+    {"long (truncated)",
+     ns_per_record([] {
+       legacy_out<lg::info_level, color>("TAG", "{:->{}}", "", 2 * CONFIG_LG_BUFFER_SIZE);
+     }, min_time),
+     ns_per_record([] {
+       lg::info<color>("TAG", "{:->{}}", "", 2 * CONFIG_LG_BUFFER_SIZE);
+     }, min_time)},
+  };
+
+  std::printf("\n%-18s %14s %14s %8s\n", "record", "fputc ns", "buffered ns", "speedup");
+  for (auto const& r : rows)
+    std::printf("%-18s %14.1f %14.1f %7.1fx\n",
+                r.name, r.legacy, r.buffered, r.legacy / r.buffered);
+}
+
+int main(int argc, char** argv) {
+  bool const quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+  output();
+  benchmark(quick ? 0.02 : 0.5);
+
+  return harness::result();
+}
@@ -0,0 +1,70 @@
+/**
+ * @file output.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief stdout capture helpers for the lg host tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_OUTPUT_HPP_
+#define COMPONENTS_LG_TEST_OUTPUT_HPP_
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace lg_test {
+
+/**
+ * Constant timestamp, to compare outputs
+ */
+struct fixed_time {
+  static std::uint32_t time() {
+    return 1234;
+  }
+};
+
+/**
+ * Runs 'func' with stdout redirected to 'path'
+ */
+template<typename Func>
+void redirect(const char* path, Func&& func) {
+  std::fflush(stdout);
+  int const saved = dup(STDOUT_FILENO);
+  int const fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  dup2(fd, STDOUT_FILENO);
+  close(fd);
+  func();
+  std::fflush(stdout);
+  dup2(saved, STDOUT_FILENO);
+  close(saved);
+}
+
+/**
+ * What 'func' writes to stdout
+ */
+template<typename Func>
+std::string capture(Func&& func) {
+  std::string const path = "lg_output_" + std::to_string(getpid()) + ".txt";
+  redirect(path.c_str(), std::forward<Func>(func));
+  std::string out;
+  if (std::FILE* fp = std::fopen(path.c_str(), "rb")) {
+    char buffer[512];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+      out.append(buffer, n);
+    std::fclose(fp);
+  }
+  std::remove(path.c_str());
+  return out;
+}
+
+}  // namespace lg_test
+
+#endif  // COMPONENTS_LG_TEST_OUTPUT_HPP_
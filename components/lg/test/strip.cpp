@@ -0,0 +1,262 @@
+/**
+ * @file strip.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Stripped format strings (CONFIG_LG_STRIP_FORMAT): not loaded, and
+ *        the binary records decoded by scripts/lg_decode.py equal to the
+ *        text output
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * lg_strip [--quick]
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <link.h>
+
+#include "lg/level.hpp"
+#include "lg/log.hpp"
+#include "lg/deferred.hpp"
+
+#include "harness.hpp"
+#include "output.hpp"
+
+#ifndef CONFIG_LG_STRIP_FORMAT
+#error "lg_strip must be built with CONFIG_LG_STRIP_FORMAT"
+#endif
+
+using harness::check;
+using lg_test::capture;
+using lg_test::fixed_time;
+
+using namespace lg::literals;
+
+using color = lg::config<true, true, fixed_time>;
+using system_time = lg::config<true, true, lg::system_timestamp>;
+
+using ring = lg::basic_deferred<16, 64>;
+using deferred = lg::deferred_config<ring, true, true, fixed_time>;
+
+enum class state : std::uint8_t { idle = 2 };
+
+struct point {
+  int x, y;
+};
+
+template<>
+struct fmt::formatter<point> {
+  constexpr auto
+  parse(fmt::format_parse_context& ctx) -> fmt::format_parse_context::iterator {
+    return ctx.end();
+  }
+
+  auto format(const point& p, fmt::format_context& ctx) const -> fmt::format_context::iterator {
+    return fmt::format_to(ctx.out(), "({}, {})", p.x, p.y);
+  }
+};
+
+/**
+ * Same records, with stripped ("..."_lg) and text format strings
+ */
+static void
+stripped() {
+  char name[] = "stack";
+  std::string const owned = "owned";
+  lg::info<color>("ADC", "{} samples, rms {:.3f}, {}"_lg, 1024, 1.2345, true);
+  lg::warn<color>("TAG", "{} {} {} {:>3}|"_lg, name, owned, std::string_view("view"), 'c');
+  lg::error<color>("TAG", "{:>6}|{:#x}|{}|{}"_lg, -12, 255u, static_cast<int>(state::idle),
+                   std::int64_t{-5000000000});
+  lg::info<color>("TAG", "{} {} {:.2f} {:+}"_lg, 0.1f, 2.0, 3.14159f, -7);
+  lg::info<color>("TAG", "no arguments"_lg);
+  lg::log<color>("Class").info("{} {}"_lg, std::uint8_t{200}, std::int16_t{-300});
+}
+
+static void
+text() {
+  char name[] = "stack";
+  std::string const owned = "owned";
+  lg::info<color>("ADC", "{} samples, rms {:.3f}, {}", 1024, 1.2345, true);
+  lg::warn<color>("TAG", "{} {} {} {:>3}|", name, owned, std::string_view("view"), 'c');
+  lg::error<color>("TAG", "{:>6}|{:#x}|{}|{}", -12, 255u, static_cast<int>(state::idle),
+                   std::int64_t{-5000000000});
+  lg::info<color>("TAG", "{} {} {:.2f} {:+}", 0.1f, 2.0, 3.14159f, -7);
+  lg::info<color>("TAG", "no arguments");
+  lg::log<color>("Class").info("{} {}", std::uint8_t{200}, std::int16_t{-300});
+}
+
+/**
+ * If 'str' is at the loaded segments of the program
+ */
+static bool
+loaded(const std::string& str) {
+  struct search {
+    std::string_view str;
+    bool found = false;
+  } s{str};
+  dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) {
+    auto& s = *static_cast<search*>(data);
+    if (info->dlpi_name && info->dlpi_name[0] != '\0')
+      return 0;     // Only the program
+    for (int i = 0; i < info->dlpi_phnum; ++i) {
+      auto const& ph = info->dlpi_phdr[i];
+      if (ph.p_type != PT_LOAD)
+        continue;
+      std::string_view const segment(
+        reinterpret_cast<const char*>(info->dlpi_addr + ph.p_vaddr), ph.p_filesz);
+      s.found = s.found || segment.find(s.str) != std::string_view::npos;
+    }
+    return 0;
+  }, &s);
+  return s.found;
+}
+
+static bool
+python() {
+  return std::system("python3 --version > /dev/null 2>&1") == 0;
+}
+
+/**
+ * scripts/lg_decode.py output of 'binary'
+ */
+static std::string
+decode(const std::string& binary) {
+  std::string const in = "lg_strip_" + std::to_string(getpid()) + ".bin";
+  if (std::FILE* fp = std::fopen(in.c_str(), "wb")) {
+    std::fwrite(binary.data(), 1, binary.size(), fp);
+    std::fclose(fp);
+  }
+  std::string const command = "python3 " LG_DECODE " --color /proc/" +
+                              std::to_string(getpid()) + "/exe " + in;
+  int status = -1;
+  auto const out = capture([&] {
+    status = std::system(command.c_str());
+  });
+  check("decoder exit", status == 0);
+  std::remove(in.c_str());
+  return out;
+}
+
+static void
+output() {
+  auto const binary = capture(stripped);
+  auto const expected = capture(text);
+
+  check("records written", !binary.empty() && binary[0] == '\x1E');
+  check("smaller than text", binary.size() < expected.size());
+  check("format not at the record", binary.find("samples") == std::string::npos);
+
+  auto const only = capture([] {
+    lg::info<color>("TAG", "only stripped {}"_lg, 1);
+    lg::info<color>("TAG", "only stripped, no arguments"_lg);
+  });
+  // Searched strings built at runtime, not to be found as literals
+  std::string const prefix = "only stripped";
+  check("format not loaded", !only.empty() &&
+                             !loaded(prefix + " {}") &&
+                             !loaded(prefix + ", no arguments"));
+  check("text format loaded", loaded(std::string("{} {} ") + "{:.2f} {:+}"));
+
+  // Argument types not supported, and not integer timestamp: text
+  auto const fallback = capture([] {
+    lg::info<color>("TAG", "{}"_lg, point{1, 2});
+  });
+  check("unsupported type as text", fallback == capture([] {
+    lg::info<color>("TAG", "{}", point{1, 2});
+  }));
+  check("system timestamp as text", capture([] {
+    lg::info<system_time>("TAG", "{}"_lg, 1);
+  })[0] != '\x1E');
+
+  check("level filtered", capture([] {
+    lg::verbose<color>("TAG", "not shown {}"_lg, 1);
+  }).empty());
+  lg::set_level("TAG", lg::level::warn);
+  check("runtime level filtered", capture([] {
+    lg::info<color>("TAG", "not shown {}"_lg, 1);
+  }).empty());
+  lg::reset_levels();
+
+  // Deferred: stored, and the binary record written by the drain
+  std::string const name = "stack";
+  auto const deferred_caller = capture([&] {
+    lg::info<deferred>("TAG", "deferred {} {:.2f}"_lg, name, 2.5);
+    lg::log<deferred>("Class").warn("{}"_lg, -7);
+  });
+  check("deferred not written by caller", deferred_caller.empty() &&
+                                          ring::stats().deferred == 2);
+  check("deferred drained as binary", capture([] { ring::drain(); }) == capture([&] {
+    lg::info<color>("TAG", "deferred {} {:.2f}"_lg, name, 2.5);
+    lg::log<color>("Class").warn("{}"_lg, -7);
+  }));
+  std::string const long_name(100, 'n');
+  check("deferred too big eager", !capture([&] {
+    lg::info<deferred>("TAG", "deferred {} {:.2f}"_lg, long_name, 2.5);
+  }).empty() && ring::stats().eager == 1);
+
+  // Strings truncated to the record size
+  std::string const big(2 * CONFIG_LG_BUFFER_SIZE, 'x');
+  auto const truncated = capture([&] {
+    lg::info<color>("TAG", "{}|{}|{}"_lg, big, 5, big);
+  });
+  check("truncated size",
+        truncated.size() <= std::min<std::size_t>(CONFIG_LG_BUFFER_SIZE, 257) &&
+        static_cast<std::uint8_t>(truncated[1]) + 2u == truncated.size());
+
+  if (!python()) {
+    std::printf("python3 not found: decoder not tested\n");
+    return;
+  }
+  auto const decoded = decode(binary);
+  check("decoded equal to text", decoded == expected);
+  if (decoded != expected)
+    std::printf("decoded:\n%s\nexpected:\n%s\n", decoded.c_str(), expected.c_str());
+
+  auto const mixed = decode("boot text\n" + binary + fallback);
+  check("decoded mixed with text", mixed == "boot text\n" + expected + fallback);
+  check("decoded truncated", decode(truncated).find("x|5|") != std::string::npos);
+}
+
+static void
+benchmark(double min_time) {
+  double stripped_ns = 0, text_ns = 0;
+  lg_test::redirect("/dev/null", [&] {
+    stripped_ns = harness::ns_per_sample(100, [] {
+      for (int i = 0; i < 100; ++i)
+        lg::info<color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz"_lg,
+                        1024, 1.2345, 59.98);
+    }, min_time);
+    text_ns = harness::ns_per_sample(100, [] {
+      for (int i = 0; i < 100; ++i)
+        lg::info<color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                        1024, 1.2345, 59.98);
+    }, min_time);
+  });
+
+  auto const stripped_size = capture([] {
+    lg::info<color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz"_lg,
+                    1024, 1.2345, 59.98);
+  }).size();
+  auto const text_size = capture([] {
+    lg::info<color>("ADC", "{} new samples, rms {:.3f} V, freq {:.2f} Hz",
+                    1024, 1.2345, 59.98);
+  }).size();
+
+  std::printf("\nstripped: %.1f ns, %zu bytes/record\n"
+              "text:     %.1f ns, %zu bytes/record\n",
+              stripped_ns, stripped_size, text_ns, text_size);
+}
+
+int main(int argc, char** argv) {
+  bool const quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+  output();
+  benchmark(quick ? 0.02 : 0.5);
+
+  return harness::result();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file esp_log.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Minimal esp_log.h for the lg host build
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_STUB_ESP_LOG_H_
+#define COMPONENTS_LG_TEST_STUB_ESP_LOG_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL     3     /* ESP_LOG_INFO */
+#endif
+
+#define LOG_COLOR_BLACK     "30"
+#define LOG_COLOR_RED       "31"
+#define LOG_COLOR_GREEN     "32"
+#define LOG_COLOR_BROWN     "33"
+#define LOG_COLOR(COLOR)    "\033[0;" COLOR "m"
+#define LOG_RESET_COLOR     "\033[0m"
+#define LOG_COLOR_E         LOG_COLOR(LOG_COLOR_RED)
+#define LOG_COLOR_W         LOG_COLOR(LOG_COLOR_BROWN)
+#define LOG_COLOR_I         LOG_COLOR(LOG_COLOR_GREEN)
+#define LOG_COLOR_D
+#define LOG_COLOR_V
+
+static inline uint32_t
+esp_log_timestamp(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+static inline uint32_t
+esp_log_early_timestamp(void) {
+  return esp_log_timestamp();
+}
+
+static inline char*
+esp_log_system_timestamp(void) {
+  static char buffer[16];
+  uint32_t const ms = esp_log_timestamp();
+  snprintf(buffer, sizeof(buffer), "%02u:%02u:%02u.%03u",
+           (unsigned)(ms / 3600000 % 24), (unsigned)(ms / 60000 % 60),
+           (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000));
+  return buffer;
+}
+
+#endif  // COMPONENTS_LG_TEST_STUB_ESP_LOG_H_
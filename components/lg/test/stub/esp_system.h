@@ -0,0 +1,23 @@
+/**
+ * @file esp_system.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Minimal esp_system.h for the lg host build
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_STUB_ESP_SYSTEM_H_
+#define COMPONENTS_LG_TEST_STUB_ESP_SYSTEM_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static inline void
+esp_system_abort(const char* details) {
+  fprintf(stderr, "abort: %s\n", details);
+  abort();
+}
+
+#endif  // COMPONENTS_LG_TEST_STUB_ESP_SYSTEM_H_
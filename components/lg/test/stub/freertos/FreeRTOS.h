@@ -0,0 +1,31 @@
+/**
+ * @file FreeRTOS.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Minimal FreeRTOS types for the lg and uc host builds
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_STUB_FREERTOS_FREERTOS_H_
+#define COMPONENTS_LG_TEST_STUB_FREERTOS_FREERTOS_H_
+
+#include <stdint.h>
+
+typedef int           BaseType_t;
+typedef unsigned      UBaseType_t;
+typedef uint32_t      TickType_t;
+typedef void*         TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdPASS                1
+#define pdFAIL                0
+#define pdTRUE                1
+#define pdFALSE               0
+#define configMAX_PRIORITIES  25
+#define pdMS_TO_TICKS(ms)     ((TickType_t)(ms))
+#define portMAX_DELAY         ((TickType_t)0xFFFFFFFF)
+#define tskNO_AFFINITY        0x7FFFFFFF
+
+#endif  // COMPONENTS_LG_TEST_STUB_FREERTOS_FREERTOS_H_
@@ -0,0 +1,170 @@
+/**
+ * @file task.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief FreeRTOS tasks as std::thread for the lg and uc host builds
+ *        (1 tick = 1 ms), with direct to task notifications
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_STUB_FREERTOS_TASK_H_
+#define COMPONENTS_LG_TEST_STUB_FREERTOS_TASK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "freertos/FreeRTOS.h"
+
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+} eNotifyAction;
+
+namespace freertos_stub {
+
+/**
+ * Notification state of a task. The handle is a pointer to it, valid while
+ * the task function runs.
+ */
+struct task {
+  std::mutex              mtx;
+  std::condition_variable cv;
+  uint32_t                value = 0;
+  bool                    pending = false;
+};
+
+inline thread_local task* current = nullptr;
+
+inline task*
+self() {
+  // Threads not created by xTaskCreate* (e.g. main)
+  static thread_local task own;
+  if (!current)
+    current = &own;
+  return current;
+}
+
+template<typename Predicate>
+inline bool
+wait(task& t, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate&& pred) {
+  if (ticks == portMAX_DELAY) {
+    t.cv.wait(lock, pred);
+    return true;
+  }
+  return t.cv.wait_for(lock, std::chrono::milliseconds(ticks), pred);
+}
+
+}  // namespace freertos_stub
+
+inline BaseType_t
+xTaskCreatePinnedToCore(TaskFunction_t func, const char*, uint32_t,
+                        void* arg, UBaseType_t, TaskHandle_t* handle,
+                        BaseType_t) {
+  auto* t = new freertos_stub::task;
+  if (handle)
+    *handle = t;
+  std::thread([func, arg, t] {
+    std::unique_ptr<freertos_stub::task> const owned(t);
+    freertos_stub::current = t;
+    func(arg);
+  }).detach();
+  return pdPASS;
+}
+
+inline BaseType_t
+xTaskCreate(TaskFunction_t func, const char* name, uint32_t stack,
+            void* arg, UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(func, name, stack, arg, priority, handle,
+                                 tskNO_AFFINITY);
+}
+
+inline TaskHandle_t
+xTaskGetCurrentTaskHandle() {
+  return freertos_stub::self();
+}
+
+inline void
+vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+/**
+ * Only deletion of the calling task, that returns right after
+ */
+inline void
+vTaskDelete(TaskHandle_t) {}
+
+inline BaseType_t
+xTaskNotify(TaskHandle_t handle, uint32_t value, eNotifyAction action) {
+  auto& t = *static_cast<freertos_stub::task*>(handle);
+  {
+    std::lock_guard lock(t.mtx);
+    switch (action) {
+      case eNoAction: break;
+      case eSetBits: t.value |= value; break;
+      case eIncrement: ++t.value; break;
+      case eSetValueWithOverwrite: t.value = value; break;
+      case eSetValueWithoutOverwrite:
+        if (t.pending)
+          return pdFAIL;
+        t.value = value;
+        break;
+    }
+    t.pending = true;
+  }
+  t.cv.notify_all();
+  return pdPASS;
+}
+
+inline BaseType_t
+xTaskNotifyGive(TaskHandle_t handle) {
+  return xTaskNotify(handle, 0, eIncrement);
+}
+
+/**
+ * The interrupt is the calling thread
+ */
+inline void
+vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* must_yield) {
+  xTaskNotifyGive(handle);
+  if (must_yield)
+    *must_yield = pdFALSE;
+}
+
+inline uint32_t
+ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+  auto& t = *freertos_stub::self();
+  std::unique_lock lock(t.mtx);
+  freertos_stub::wait(t, lock, ticks, [&t] { return t.value != 0; });
+  uint32_t const value = t.value;
+  if (value != 0)
+    t.value = clear_on_exit ? 0 : value - 1;
+  t.pending = false;
+  return value;
+}
+
+inline BaseType_t
+xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                uint32_t* value, TickType_t ticks) {
+  auto& t = *freertos_stub::self();
+  std::unique_lock lock(t.mtx);
+  if (!t.pending)
+    t.value &= ~clear_on_entry;
+  if (!freertos_stub::wait(t, lock, ticks, [&t] { return t.pending; }))
+    return pdFAIL;
+  if (value)
+    *value = t.value;
+  t.value &= ~clear_on_exit;
+  t.pending = false;
+  return pdPASS;
+}
+
+#endif  // COMPONENTS_LG_TEST_STUB_FREERTOS_TASK_H_
@@ -0,0 +1,17 @@
+/**
+ * @file sdkconfig.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Host build configuration. Options can be set at the command line
+ *        (-DCONFIG_LG_BUFFER_SIZE=128)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_LG_TEST_STUB_SDKCONFIG_H_
+#define COMPONENTS_LG_TEST_STUB_SDKCONFIG_H_
+
+#define CONFIG_LOG_COLORS   1
+
+#endif  // COMPONENTS_LG_TEST_STUB_SDKCONFIG_H_
@@ -0,0 +1,43 @@
+/**
+ * @file log_levels.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Persists the lg runtime log levels (lg/levels.hpp) at NVS
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * sys::nvs storage("config");
+ * sys::load_log_levels(storage);         // At boot
+ *
+ * lg::apply_levels("*:W,wifi:D");        // e.g. from a HTTP request
+ * sys::save_log_levels(storage);
+ */
+#ifndef COMPONENTS_SYS_LOG_LEVELS_HPP_
+#define COMPONENTS_SYS_LOG_LEVELS_HPP_
+
+#include "sys/error.hpp"
+#include "sys/nvs.hpp"
+
+namespace sys {
+
+inline constexpr const char* log_levels_key = "lg_levels";
+
+/**
+ * Saves lg::format_levels() as string, and commits. ESP_ERR_INVALID_SIZE
+ * if the levels don't fit lg::levels_string_size.
+ */
+error
+save_log_levels(nvs& storage, const char* key = log_levels_key) noexcept;
+
+/**
+ * Applies the saved levels. ESP_ERR_NVS_NOT_FOUND if nothing was saved;
+ * ESP_ERR_INVALID_ARG if invalid (nothing applied) or the tags table is
+ * full.
+ */
+error
+load_log_levels(nvs& storage, const char* key = log_levels_key) noexcept;
+
+}  // namespace sys
+
+#endif  // COMPONENTS_SYS_LOG_LEVELS_HPP_
@@ -40,6 +40,25 @@ task_create(TaskFunction_t func,
   return handler;
 }
 
+/**
+ * @see https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/system/freertos_idf.html (xTaskCreatePinnedToCore)
+ *
+ * 'core' can be tskNO_AFFINITY
+ */
+inline task_handle
+task_create_pinned(TaskFunction_t func,
+                   std::uint32_t stack_size,
+                   UBaseType_t priority,
+                   BaseType_t core,
+                   void* parameter = nullptr,
+                   const char* name = "") noexcept {
+  task_handle handler = nullptr;
+  if (xTaskCreatePinnedToCore(func, name, stack_size, parameter,
+                              priority, &handler, core) != pdPASS)
+    return nullptr;
+  return handler;
+}
+
 /**
  * @see https://www.freertos.org/a00021.html#xTaskGetCurrentTaskHandle
  */
@@ -0,0 +1,40 @@
+/**
+ * @file log_levels.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstddef>
+
+#include "lg/levels.hpp"
+
+#include "sys/error.hpp"
+#include "sys/nvs.hpp"
+#include "sys/log_levels.hpp"
+
+namespace sys {
+
+error
+save_log_levels(nvs& storage, const char* key /* = log_levels_key */) noexcept {
+  char buffer[lg::levels_string_size];
+  if (lg::format_levels(buffer, sizeof(buffer)) == 0)
+    return ESP_ERR_INVALID_SIZE;
+  if (auto err = storage.set(key, buffer); err)
+    return err;
+  return storage.commit();
+}
+
+error
+load_log_levels(nvs& storage, const char* key /* = log_levels_key */) noexcept {
+  char buffer[lg::levels_string_size];
+  std::size_t size = sizeof(buffer);
+  if (auto err = storage.get(key, buffer, size); err)
+    return err;
+  return lg::apply_levels(buffer) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+}  // namespace sys
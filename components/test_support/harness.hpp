@@ -0,0 +1,120 @@
+/**
+ * @file harness.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Minimal check/benchmark helpers and synthetic signals for the host
+ *        tests of the components (wave, lg, uc)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_TEST_SUPPORT_HARNESS_HPP_
+#define COMPONENTS_TEST_SUPPORT_HARNESS_HPP_
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+namespace harness {
+
+inline int errors = 0;
+
+inline bool
+check(const char* name, double value, double expected, double tolerance) noexcept {
+  bool const ok = std::abs(value - expected) <= tolerance;
+  std::printf("%s %-40s %.6f (expected %.6f, tolerance %.1e)\n",
+              ok ? "[ OK ]" : "[FAIL]", name, value, expected, tolerance);
+  errors += !ok;
+  return ok;
+}
+
+inline bool
+check(const char* name, bool ok) noexcept {
+  std::printf("%s %s\n", ok ? "[ OK ]" : "[FAIL]", name);
+  errors += !ok;
+  return ok;
+}
+
+inline int
+result() noexcept {
+  std::printf("%s\n", errors == 0 ? "All checks passed" : "Some checks failed");
+  return errors != 0;
+}
+
+/**
+ * Average ns per sample of 'func' over 'samples' samples. Runs at least
+ * 'min_time' seconds, after one warm up call.
+ */
+template<typename Func>
+double
+ns_per_sample(std::size_t samples, Func&& func, double min_time = 0.05) noexcept {
+  using clock = std::chrono::steady_clock;
+  func();
+  std::size_t rounds = 0;
+  auto const start = clock::now();
+  std::chrono::duration<double> elapsed{};
+  do {
+    func();
+    ++rounds;
+    elapsed = clock::now() - start;
+  } while (elapsed.count() < min_time);
+  return elapsed.count() * 1e9 / (static_cast<double>(rounds) * samples);
+}
+
+/**
+ * Keeps the compiler from optimizing away a result
+ */
+template<typename T>
+inline void
+keep(const T& value) noexcept {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct signal {
+  double offset = 2048;
+  double amplitude = 1000;
+  double frequency = 60;
+  double sample_freq = 7680;
+  double phase = 0;
+  double noise = 0;                   // Standard deviation
+  std::vector<double> harmonics{};    // Relative amplitude of 2nd, 3rd, ...
+
+  [[nodiscard]] double
+  rms() const noexcept {
+    double sum = 1;
+    for (double h : harmonics)
+      sum += h * h;
+    return amplitude * std::sqrt(sum / 2);
+  }
+
+  template<typename T>
+  [[nodiscard]] std::vector<T>
+  make(std::size_t size, unsigned seed = 42) const {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0, noise > 0 ? noise : 1);
+    std::vector<T> out(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      double const w = 2 * M_PI * frequency * i / sample_freq + phase;
+      double v = offset + amplitude * std::sin(w);
+      for (std::size_t h = 0; h < harmonics.size(); ++h)
+        v += amplitude * harmonics[h] * std::sin((h + 2) * w);
+      if (noise > 0)
+        v += dist(gen);
+      if constexpr (std::is_integral_v<T>)
+        out[i] = static_cast<T>(std::clamp(std::lround(v), 0l, 4095l));
+      else
+        out[i] = static_cast<T>(v);
+    }
+    return out;
+  }
+};
+
+}  // namespace harness
+
+#endif  // COMPONENTS_TEST_SUPPORT_HARNESS_HPP_
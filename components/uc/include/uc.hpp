@@ -8,8 +8,13 @@
  * @copyright Copyright (c) 2023
  * 
  */
+#ifndef COMPONENTS_UC_HPP_
+#define COMPONENTS_UC_HPP_
+
 #include <cstdint>
 
+#include "sdkconfig.h"
+
 namespace uc {
 
 enum class adc_stream_format {
@@ -18,6 +23,14 @@ enum class adc_stream_format {
   type1_2
 };
 
+/**
+ * Output format used by a MCU that supports both (ESP32S2): type1
+ */
+[[nodiscard]] constexpr adc_stream_format
+resolve_format(adc_stream_format format) noexcept {
+  return format == adc_stream_format::type1_2 ? adc_stream_format::type1 : format;
+}
+
 template<adc_stream_format Type>
 struct mcu {
   struct ADC {
@@ -52,8 +65,11 @@ using compiled_mcu = esp32s3;
 #elif CONFIG_IDF_TARGET_ESP32C6
 using compiled_mcu = esp32c6;
 #elif CONFIG_IDF_TARGET_ESP32H2
+using compiled_mcu = esp32h2;
 #else
   #error "Unknown MCU"
 #endif
 
 }  // namespace uc
+
+#endif  // COMPONENTS_UC_HPP_
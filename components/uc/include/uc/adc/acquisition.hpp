@@ -0,0 +1,294 @@
+/**
+ * @file acquisition.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC acquisition service: reader task filling ping-pong buffers and
+ *        a processing task consuming them
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * using adc_acquisition = uc::adc::acquisition<uc::adc::stream>;
+ *
+ * void process(adc_acquisition::span_type samples, void* arg) { ... }
+ *
+ * adc_acquisition acq(adc, {.buffer_samples = 1024}, process);
+ * acq.start();
+ *
+ * Any uc::adc::backend can be the source: uc::adc::replay runs the same
+ * service on Linux.
+ */
+#ifndef COMPONENTS_UC_ADC_ACQUISITION_HPP_
+#define COMPONENTS_UC_ADC_ACQUISITION_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <span>
+
+#include "esp_attr.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sys/error.hpp"
+#include "sys/task.hpp"
+
+#include "uc/adc/backend.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * The reader task is woken at every conversion frame and drains the driver
+ * pool into the current buffer. When the buffer is full it is handed to the
+ * processing task, and the reader continues at the other buffer.
+ *
+ * The processing callback has the time of one buffer to finish: if both
+ * buffers are still owned by it, the just filled buffer is discarded
+ * (dropped_buffers) and the reader keeps filling it, so the reader never
+ * blocks. Processing latency is bounded to one buffer period. The callback
+ * runs at the processing task, that stop() waits for: calling stop() from
+ * it fails (ESP_ERR_INVALID_STATE), stop from another task.
+ *
+ * The service registers the backend event handler.
+ */
+template<backend Backend>
+class acquisition {
+ public:
+  using backend_type = Backend;
+  using data = typename Backend::data;
+  using span_type = std::span<const data>;
+  using callback = void(*)(span_type, void*);
+
+  struct config {
+    std::size_t   buffer_samples;
+    std::uint32_t reader_stack = 3072;
+    UBaseType_t   reader_priority = configMAX_PRIORITIES - 2;
+    BaseType_t    reader_core = tskNO_AFFINITY;
+    std::uint32_t process_stack = 4096;
+    UBaseType_t   process_priority = 5;
+    BaseType_t    process_core = tskNO_AFFINITY;
+  };
+
+  struct statistics {
+    std::uint32_t buffers;            // Handed to processing
+    std::uint32_t dropped_buffers;    // Processing busy
+    std::uint32_t pool_overflows;     // Driver pool full (on_pool_ovf)
+  };
+
+  acquisition(Backend& adc,
+              const config& cfg,
+              callback cb,
+              void* arg = nullptr) noexcept
+   : adc_(adc), cfg_(cfg), cb_(cb), arg_(arg) {
+    assert(cfg.buffer_samples > 0 && "Buffer must have at least one sample");
+    assert(cb != nullptr && "Callback must be defined");
+    buffers_[0].reset(new (std::nothrow) data[cfg.buffer_samples]);
+    buffers_[1].reset(new (std::nothrow) data[cfg.buffer_samples]);
+  }
+  acquisition(const acquisition&) = delete;
+  acquisition& operator=(const acquisition&) = delete;
+
+  ~acquisition() noexcept {
+    stop();
+  }
+
+  /**
+   * Creates the tasks and starts the backend
+   */
+  sys::error start() noexcept {
+    if (!buffers_[0] || !buffers_[1])
+      return ESP_ERR_NO_MEM;
+    if (running_.load(std::memory_order_acquire))
+      return ESP_ERR_INVALID_STATE;
+
+    fill_ = 0;
+    write_ = 0;
+    busy_[0] = busy_[1] = false;
+
+    auto err = adc_.register_handler({
+      .on_conv_done = on_conv_done,
+      .on_pool_ovf = on_pool_ovf
+    }, this);
+    if (err)
+      return err;
+
+    running_.store(true, std::memory_order_release);
+    tasks_ = 2;
+    processor_ = sys::task_create_pinned(process_task,
+                                         cfg_.process_stack,
+                                         cfg_.process_priority,
+                                         cfg_.process_core,
+                                         this, "adc process");
+    reader_ = sys::task_create_pinned(reader_task,
+                                      cfg_.reader_stack,
+                                      cfg_.reader_priority,
+                                      cfg_.reader_core,
+                                      this, "adc reader");
+    if (!processor_ || !reader_) {
+      tasks_ -= !processor_ + !reader_;
+      stop();
+      return ESP_ERR_NO_MEM;
+    }
+
+    err = adc_.start();
+    if (err)
+      stop();
+    return err;
+  }
+
+  /**
+   * Stops the backend, waits for both tasks to exit and unregisters the
+   * event handler. The processing task is only told to exit by the reader,
+   * on its way out: the reader is the one that notifies it.
+   *
+   * Not from the processing callback: it would wait for its own task.
+   */
+  sys::error stop() noexcept {
+    if (processor_ && xTaskGetCurrentTaskHandle() == processor_)
+      return ESP_ERR_INVALID_STATE;
+    if (!running_.exchange(false, std::memory_order_acq_rel))
+      return ESP_OK;
+
+    auto err = adc_.stop();
+    if (reader_)
+      xTaskNotifyGive(reader_);
+    else if (processor_)
+      xTaskNotify(processor_, exit_bit, eSetBits);
+    while (tasks_.load(std::memory_order_acquire) != 0)
+      vTaskDelay(1);
+    reader_ = processor_ = nullptr;
+    // The backend must not call a stopped (or destroyed) service
+    auto const unregistered = adc_.register_handler({}, nullptr);
+    return err ? err : unregistered;
+  }
+
+  [[nodiscard]] bool
+  is_running() const noexcept {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] statistics
+  stats() const noexcept {
+    return {
+      buffers_count_.load(std::memory_order_relaxed),
+      dropped_.load(std::memory_order_relaxed),
+      overflows_.load(std::memory_order_relaxed)
+    };
+  }
+
+ private:
+  using handler = typename Backend::handler;
+  using event_data = typename Backend::event_data;
+
+  static constexpr const std::uint32_t exit_bit = 1u << 2;
+
+  static bool IRAM_ATTR
+  on_conv_done(handler, const event_data*, void* arg) noexcept {
+    auto* self = static_cast<acquisition*>(arg);
+    BaseType_t must_yield = pdFALSE;
+    if (self->reader_)
+      vTaskNotifyGiveFromISR(self->reader_, &must_yield);
+    return must_yield == pdTRUE;
+  }
+
+  static bool IRAM_ATTR
+  on_pool_ovf(handler, const event_data*, void* arg) noexcept {
+    static_cast<acquisition*>(arg)->overflows_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  static void
+  reader_task(void* arg) noexcept {
+    auto* self = static_cast<acquisition*>(arg);
+    while (true) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      if (!self->running_.load(std::memory_order_acquire))
+        break;
+      self->read();
+    }
+    if (self->processor_)
+      xTaskNotify(self->processor_, exit_bit, eSetBits);
+    self->tasks_.fetch_sub(1, std::memory_order_release);
+    sys::task_delete();
+  }
+
+  static void
+  process_task(void* arg) noexcept {
+    auto* self = static_cast<acquisition*>(arg);
+    while (true) {
+      std::uint32_t ready = 0;
+      xTaskNotifyWait(0, UINT32_MAX, &ready, portMAX_DELAY);
+      if (ready & exit_bit)
+        break;
+      for (unsigned i = 0; i < 2; ++i) {
+        if (ready & (1u << i)) {
+          self->cb_(span_type(self->buffers_[i].get(), self->cfg_.buffer_samples),
+                    self->arg_);
+          self->busy_[i].store(false, std::memory_order_release);
+        }
+      }
+    }
+    self->tasks_.fetch_sub(1, std::memory_order_release);
+    sys::task_delete();
+  }
+
+  /**
+   * Drains the driver pool
+   */
+  void read() noexcept {
+    while (true) {
+      auto result = adc_.read(buffers_[write_].get() + fill_,
+                              cfg_.buffer_samples - fill_, 0);
+      if (!result)
+        break;
+      fill_ += result.readed;
+      if (fill_ == cfg_.buffer_samples)
+        hand_off();
+    }
+  }
+
+  void hand_off() noexcept {
+    fill_ = 0;
+    unsigned const other = write_ ^ 1;
+    if (busy_[other].load(std::memory_order_acquire)) {
+      // Processing still owns the other buffer: discard this one
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    busy_[write_].store(true, std::memory_order_release);
+    buffers_count_.fetch_add(1, std::memory_order_relaxed);
+    xTaskNotify(processor_, 1u << write_, eSetBits);
+    write_ = other;
+  }
+
+  Backend&                    adc_;
+  config                      cfg_;
+  callback                    cb_;
+  void*                       arg_;
+
+  std::unique_ptr<data[]>     buffers_[2];
+  std::size_t                 fill_ = 0;
+  unsigned                    write_ = 0;
+  std::atomic<bool>           busy_[2]{false, false};
+
+  sys::task_handle            reader_ = nullptr;
+  sys::task_handle            processor_ = nullptr;
+  std::atomic<bool>           running_{false};
+  std::atomic<int>            tasks_{0};
+
+  std::atomic<std::uint32_t>  buffers_count_{0};
+  std::atomic<std::uint32_t>  dropped_{0};
+  std::atomic<std::uint32_t>  overflows_{0};
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_ACQUISITION_HPP_
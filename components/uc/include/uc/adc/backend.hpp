@@ -0,0 +1,65 @@
+/**
+ * @file backend.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Interface common to the ADC continuous sources
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Implemented by uc::adc::stream (driver) and uc::adc::replay (host). Code
+ * that consumes samples can be written against the concept and run on the
+ * board or on Linux, as uc::adc::acquisition and uc::adc::frame_ring:
+ *
+ * template<uc::adc::backend Backend>
+ * void consume(Backend& adc) { ... adc.read(data, size, 0) ... }
+ */
+#ifndef COMPONENTS_UC_ADC_BACKEND_HPP_
+#define COMPONENTS_UC_ADC_BACKEND_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <concepts>
+
+namespace uc {
+namespace adc {
+
+/**
+ * Record with channel()/value()/is_valid(unit)
+ */
+template<typename Data>
+concept record = requires(const Data& data) {
+  typename Data::value_type;
+  { data.channel() };
+  { data.value() };
+  { data.is_valid(std::uint32_t{}) } -> std::convertible_to<bool>;
+};
+
+template<typename Backend>
+concept backend = record<typename Backend::data> &&
+                  requires(Backend& adc,
+                           typename Backend::data* data,
+                           std::size_t size,
+                           const typename Backend::callback& cb,
+                           const typename Backend::event_data& ev,
+                           const typename Backend::result& res) {
+  // on_conv_done/on_pool_ovf(handler, event data*, user data*)
+  typename Backend::handler;
+  { cb.on_conv_done };
+  { cb.on_pool_ovf };
+  { ev.conv_frame_buffer } -> std::convertible_to<const std::uint8_t*>;
+  { ev.size } -> std::convertible_to<std::uint32_t>;
+
+  { adc.is_initiated() } -> std::convertible_to<bool>;
+  { adc.start() };
+  { adc.stop() };
+  { adc.register_handler(cb, nullptr) };
+  { adc.read(data, size, 0) } -> std::same_as<typename Backend::result>;
+  { res.readed } -> std::convertible_to<std::uint32_t>;
+  { static_cast<bool>(res) };
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_BACKEND_HPP_
@@ -0,0 +1,203 @@
+/**
+ * @file basic_stream.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC continuous stream with output format and channels fixed at
+ *        compile time
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * using voltage = uc::adc::channel<ADC_UNIT_1, ADC_CHANNEL_0>;
+ * using current = uc::adc::channel<ADC_UNIT_1, ADC_CHANNEL_3>;
+ * using adc_type = uc::adc::basic_stream<uc::compiled_mcu, voltage, current>;
+ *
+ * adc_type adc({.max_store_buf_size = 4092, .conv_frame_size = 1400});
+ * adc.configure(26 * 1000);
+ * ...
+ * auto r = adc.read(data, size, 0);
+ * for (auto& d : std::span(data, r.readed))
+ *   if (adc_type::is<1>(d)) ... // current sample
+ */
+#ifndef COMPONENTS_UC_ADC_BASIC_STREAM_HPP_
+#define COMPONENTS_UC_ADC_BASIC_STREAM_HPP_
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <span>
+#include <tuple>
+#include <chrono>
+
+#include "esp_adc/adc_continuous.h"
+
+#include "sys/error.hpp"
+#include "sys/time.hpp"
+
+#include "uc.hpp"
+#include "uc/adc/data.hpp"
+#include "uc/adc/demux.hpp"
+#include "uc/adc/stream.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * Channel descriptor
+ */
+template<adc_unit_t Unit,
+         adc_channel_t Channel,
+         adc_atten_t Atten = ADC_ATTEN_DB_12,
+         std::uint8_t BitWidth = SOC_ADC_DIGI_MAX_BITWIDTH>
+struct channel {
+  static constexpr const adc_unit_t unit = Unit;
+  static constexpr const adc_channel_t number = Channel;
+  static constexpr const adc_atten_t atten = Atten;
+  static constexpr const std::uint8_t bit_width = BitWidth;
+
+  [[nodiscard]] static constexpr adc_digi_pattern_config_t
+  pattern() noexcept {
+    return {
+      .atten      = static_cast<std::uint8_t>(Atten),
+      .channel    = static_cast<std::uint8_t>(Channel & 0x7),
+      .unit       = static_cast<std::uint8_t>(Unit),
+      .bit_width  = BitWidth
+    };
+  }
+};
+
+/**
+ * Stream of the MCU 'Target' (as uc::compiled_mcu) sampling 'Channels', in
+ * this order.
+ *
+ * The output format, the conversion mode and the pattern table are
+ * constants, and the record type only has the accessors of its format.
+ */
+template<typename Target, typename ...Channels>
+class basic_stream {
+ public:
+  static constexpr const std::size_t channels = sizeof...(Channels);
+  static constexpr const adc_stream_format format =
+    resolve_format(Target::ADC::continuous::format);
+
+  using data = basic_data<format>;
+  using value_type = typename data::value_type;
+  using result = stream::result;
+  using demux_type = demux<channels, data>;
+  template<std::size_t I>
+  using channel_type = std::tuple_element_t<I, std::tuple<Channels...>>;
+
+  static_assert(channels > 0, "At least one channel must be defined");
+  static_assert(channels <= SOC_ADC_PATT_LEN_MAX, "Too many channels");
+  static_assert(Target::ADC::continuous::format ==
+                  compiled_mcu::ADC::continuous::format,
+                "Target format not supported by the compiled MCU");
+
+  static constexpr const bool single_unit =
+    ((Channels::unit == channel_type<0>::unit) && ...);
+
+  static_assert(format != adc_stream_format::type1 || single_unit,
+                "Type 1 format support only one ADC unit");
+
+  static constexpr const adc_digi_convert_mode_t conv_mode =
+    !single_unit
+      ? ADC_CONV_BOTH_UNIT
+      : (channel_type<0>::unit == ADC_UNIT_1 ? ADC_CONV_SINGLE_UNIT_1
+                                              : ADC_CONV_SINGLE_UNIT_2);
+
+  static constexpr const std::array<adc_digi_pattern_config_t, channels>
+  patterns{Channels::pattern()...};
+
+  basic_stream() noexcept = default;
+  basic_stream(const stream::config& cfg) noexcept
+   : stream_(cfg) {}
+
+  [[nodiscard]] bool
+  is_initiated() const noexcept {
+    return stream_.is_initiated();
+  }
+
+  sys::error init(const stream::config& cfg) noexcept {
+    return stream_.init(cfg);
+  }
+
+  /**
+   * Configures the pattern, conversion mode and format. 'sample_freq_hz'
+   * is the total conversion rate (all channels).
+   */
+  sys::error configure(std::uint32_t sample_freq_hz) noexcept {
+    // Copied by the driver
+    auto ptt = patterns;
+    return stream_.configure({
+      .pattern_num    = channels,
+      .adc_pattern    = ptt.data(),
+      .sample_freq_hz = sample_freq_hz,
+      .conv_mode      = conv_mode,
+      .format         = data::output_format,
+    });
+  }
+
+  sys::error start() noexcept {
+    return stream_.start();
+  }
+
+  sys::error stop() noexcept {
+    return stream_.stop();
+  }
+
+  sys::error register_handler(const stream::callback& cb,
+                              void* user_data = nullptr) noexcept {
+    return stream_.register_handler(cb, user_data);
+  }
+
+  result read(data* dt, std::size_t size, sys::time::ticks ticks) noexcept {
+    return stream_.read(&dt->raw_data(), size, ticks);
+  }
+
+  template<typename Rep, typename Ratio>
+  result read(data* dt, std::size_t size,
+              std::chrono::duration<Rep, Ratio> duration) noexcept {
+    return read(dt, size, sys::time::to_ticks(duration));
+  }
+
+  /**
+   * True if 'd' is a sample of the I-th channel
+   */
+  template<std::size_t I>
+  [[nodiscard]] static constexpr bool
+  is(const data& d) noexcept {
+    using ch = channel_type<I>;
+    if constexpr (format == adc_stream_format::type2 && !single_unit)
+      return d.channel() == (ch::number & 0x7) && d.unit() == ch::unit;
+    else
+      return d.channel() == (ch::number & 0x7);
+  }
+
+  /**
+   * Demux of the channels (in order) into 'buffers'. Single unit only.
+   */
+  [[nodiscard]] static constexpr demux_type
+  make_demux(const typename demux_type::buffers_type& buffers) noexcept {
+    static_assert(single_unit, "Demux supports only one ADC unit");
+    return demux_type(channel_type<0>::unit,
+                      {static_cast<std::uint32_t>(Channels::number & 0x7)...},
+                      buffers);
+  }
+
+  /**
+   * Underlying stream (e.g. to attach a frame_ring)
+   */
+  [[nodiscard]] stream&
+  native() noexcept {
+    return stream_;
+  }
+
+ private:
+  stream stream_;
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_BASIC_STREAM_HPP_
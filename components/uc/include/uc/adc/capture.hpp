@@ -0,0 +1,311 @@
+/**
+ * @file capture.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Oscilloscope like triggered capture with pre-trigger history
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * static uc::adc::capture<256, 768> scope({
+ *   .mode = uc::adc::trigger::type::rising,
+ *   .level = 3000,
+ *   .hysteresis = 20
+ * });
+ *
+ * // Acquisition path
+ * scope.push(data, size, ADC_CHANNEL_0);
+ *
+ * // Any other task
+ * if (auto* frame = scope.acquire()) {
+ *   client.send(*frame);     // websocket::client, binary
+ *   scope.release();
+ * }
+ */
+#ifndef COMPONENTS_UC_ADC_CAPTURE_HPP_
+#define COMPONENTS_UC_ADC_CAPTURE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace uc {
+namespace adc {
+
+struct trigger {
+  enum class type : std::uint8_t {
+    rising,       // Crosses 'level' upwards
+    falling,      // Crosses 'level' downwards
+    slope         // |x[n] - x[n - 1]| >= level
+  };
+
+  type          mode = type::rising;
+  std::int32_t  level = 0;
+  // Rising/falling: the signal must go 'hysteresis' to the other side of
+  // the level to arm the next trigger
+  std::int32_t  hysteresis = 0;
+  // Re-arm automatically after a capture
+  bool          auto_rearm = true;
+};
+
+/**
+ * Keeps the last Pre samples. When the trigger fires, the history and the
+ * next Post samples are frozen into a frame.
+ *
+ * There are two frames: while one is borrowed by the consumer (acquire()
+ * / release(), e.g. sending it over websocket), the other is used by the
+ * next capture, so acquisition never stops. If a capture completes while
+ * the consumer still holds the other frame, it is discarded (missed()) and
+ * the trigger rearmed. Nothing is allocated: all storage is inside the
+ * object.
+ *
+ * push() must be called from one task only, as acquire()/release().
+ */
+template<std::size_t Pre, std::size_t Post, typename T = std::uint16_t>
+class capture {
+ public:
+  using value_type = T;
+  static constexpr const std::size_t pre = Pre;
+  static constexpr const std::size_t post = Post;
+  static constexpr const std::size_t size = Pre + Post;
+
+  static_assert(Post > 0, "Post trigger must have at least one sample");
+  static_assert(Pre + Post <= 65535, "Frame must fit a 16 bits length");
+  static_assert(std::is_integral_v<T>, "Must be a integral type");
+
+  /**
+   * Exported capture. Trivially copyable, can be sent as is.
+   */
+  struct frame {
+    std::uint32_t               sequence;
+    std::uint32_t               trigger_sample;   // Absolute sample index
+    std::uint16_t               trigger_index;    // Pre
+    std::uint16_t               length;           // size
+    std::array<value_type, size> samples;
+  };
+
+  static_assert(std::is_trivially_copyable_v<frame>);
+
+  enum class state {
+    idle,
+    armed,
+    triggered
+  };
+
+  constexpr
+  capture(const trigger& trg = {}) noexcept
+   : trigger_(trg) {}
+
+  /**
+   * Pushes one sample. Returns true if a capture was completed.
+   */
+  bool push(value_type x) noexcept {
+    bool completed = false;
+    switch (state_) {
+      case state::idle:
+        break;
+      case state::armed:
+        if (history_ >= Pre && fire(x))
+          completed = start(x);
+        break;
+      case state::triggered:
+        current().samples[fill_++] = x;
+        if (fill_ == size) {
+          completed = finish();
+        }
+        break;
+    }
+
+    if constexpr (Pre > 0) {
+      ring_[head_] = x;
+      head_ = head_ + 1 == Pre ? 0 : head_ + 1;
+      if (history_ < Pre)
+        ++history_;
+    }
+    prev_ = x;
+    has_prev_ = true;
+    ++samples_;
+    return completed;
+  }
+
+  /**
+   * Values of a range. Records (as stream::data) have value() read.
+   */
+  template<typename Iter>
+  std::size_t push(Iter begin, Iter end) noexcept {
+    std::size_t completed = 0;
+    while (begin != end) {
+      if constexpr (std::is_class_v<std::remove_cvref_t<decltype(*begin)>>)
+        completed += push(static_cast<value_type>(begin->value()));
+      else
+        completed += push(static_cast<value_type>(*begin));
+      ++begin;
+    }
+    return completed;
+  }
+
+  /**
+   * Only the samples of 'channel' of interleaved ADC records (stream::data)
+   */
+  template<typename Data>
+  std::size_t push(const Data* data,
+                   std::size_t count,
+                   std::uint32_t channel) noexcept {
+    std::size_t completed = 0;
+    for (std::size_t i = 0; i < count; ++i)
+      if (data[i].channel() == channel)
+        completed += push(static_cast<value_type>(data[i].value()));
+    return completed;
+  }
+
+  void arm() noexcept {
+    state_ = state::armed;
+    crossed_ = false;
+  }
+
+  void arm(const trigger& trg) noexcept {
+    trigger_ = trg;
+    arm();
+  }
+
+  void disarm() noexcept {
+    state_ = state::idle;
+  }
+
+  [[nodiscard]] state
+  status() const noexcept {
+    return state_;
+  }
+
+  /**
+   * Last completed frame, or nullptr. Valid until release().
+   *
+   * The borrow is confirmed by reading 'ready_' again: if push() completed
+   * the other frame in between, it may already be writing at the one just
+   * borrowed, so try again with the new one. Stores and loads of 'ready_'
+   * and 'borrowed_' are sequentially consistent: either this sees the new
+   * frame, or finish() sees the borrow (and discards its capture).
+   */
+  [[nodiscard]] const frame*
+  acquire() noexcept {
+    int ready = ready_.load();
+    while (ready >= 0) {
+      borrowed_.store(ready);
+      int const now = ready_.load();
+      if (now == ready)
+        return &frames_[ready];
+      ready = now;
+    }
+    borrowed_.store(-1);
+    return nullptr;
+  }
+
+  void release() noexcept {
+    int const borrowed = borrowed_.load(std::memory_order_relaxed);
+    int expected = borrowed;
+    ready_.compare_exchange_strong(expected, -1, std::memory_order_acq_rel);
+    borrowed_.store(-1, std::memory_order_release);
+  }
+
+  /**
+   * Completed captures discarded because the consumer held the other frame
+   */
+  [[nodiscard]] std::uint32_t
+  missed() const noexcept {
+    return missed_;
+  }
+
+  [[nodiscard]] std::uint32_t
+  captures() const noexcept {
+    return sequence_;
+  }
+
+ private:
+  frame& current() noexcept {
+    return frames_[write_];
+  }
+
+  bool fire(value_type x) noexcept {
+    auto const v = static_cast<std::int32_t>(x);
+    switch (trigger_.mode) {
+      case trigger::type::rising:
+        if (v <= trigger_.level - trigger_.hysteresis)
+          crossed_ = true;
+        return crossed_ && v >= trigger_.level;
+      case trigger::type::falling:
+        if (v >= trigger_.level + trigger_.hysteresis)
+          crossed_ = true;
+        return crossed_ && v <= trigger_.level;
+      case trigger::type::slope: {
+        if (!has_prev_)
+          return false;
+        auto const diff = v - static_cast<std::int32_t>(prev_);
+        return (diff < 0 ? -diff : diff) >= trigger_.level;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Returns true if the capture was completed (Post == 1)
+   */
+  bool start(value_type x) noexcept {
+    frame& f = current();
+    if constexpr (Pre > 0) {
+      // Oldest sample is at head_
+      std::size_t const first = Pre - head_;
+      std::memcpy(f.samples.data(), ring_.data() + head_, first * sizeof(T));
+      std::memcpy(f.samples.data() + first, ring_.data(), head_ * sizeof(T));
+    }
+    f.trigger_sample = samples_;
+    f.trigger_index = static_cast<std::uint16_t>(Pre);
+    f.length = static_cast<std::uint16_t>(size);
+    f.samples[Pre] = x;
+    fill_ = Pre + 1;
+    state_ = state::triggered;
+    return fill_ == size && finish();
+  }
+
+  bool finish() noexcept {
+    state_ = trigger_.auto_rearm ? state::armed : state::idle;
+    crossed_ = false;
+
+    int const other = write_ ^ 1;
+    if (borrowed_.load() == other) {
+      ++missed_;
+      return false;
+    }
+    current().sequence = sequence_++;
+    ready_.store(write_);
+    write_ = other;
+    return true;
+  }
+
+  trigger                     trigger_;
+  state                       state_ = state::idle;
+  bool                        crossed_ = false;
+  value_type                  prev_ = 0;
+  bool                        has_prev_ = false;
+
+  std::array<value_type, Pre> ring_{};
+  std::size_t                 head_ = 0;
+  std::size_t                 history_ = 0;
+  std::uint32_t               samples_ = 0;
+
+  std::array<frame, 2>        frames_{};
+  int                         write_ = 0;
+  std::size_t                 fill_ = 0;
+  std::atomic<int>            ready_{-1};
+  std::atomic<int>            borrowed_{-1};
+  std::uint32_t               sequence_ = 0;
+  std::uint32_t               missed_ = 0;
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_CAPTURE_HPP_
@@ -0,0 +1,117 @@
+/**
+ * @file data.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC continuous conversion record, by output format
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_ADC_DATA_HPP_
+#define COMPONENTS_UC_ADC_DATA_HPP_
+
+#include <cstdint>
+#include <utility>
+
+#include "hal/adc_types.h"
+#include "soc/soc_caps.h"
+
+#include "uc.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * Record of one conversion as written by the driver.
+ *
+ * The format is selected at compile time. Only the fields of the selected
+ * format are accessed (Raw is a template parameter, so the other format is
+ * never instantiated at targets that don't define it).
+ */
+template<adc_stream_format Format,
+         typename Raw = adc_digi_output_data_t>
+class basic_data;
+
+template<typename Raw>
+class basic_data<adc_stream_format::type1, Raw> {
+ public:
+  using value_type = decltype(std::declval<Raw>().val);
+  static constexpr const adc_stream_format format = adc_stream_format::type1;
+  static constexpr const adc_digi_output_format_t output_format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+  value_type channel() const noexcept {
+    return data_.type1.channel;
+  }
+
+  value_type value() const noexcept {
+    return data_.type1.data;
+  }
+
+  bool is_valid(std::uint32_t unit) const noexcept {
+    return channel() < SOC_ADC_CHANNEL_NUM(unit);
+  }
+
+  Raw&
+  raw_data() noexcept {
+    return data_;
+  }
+
+  const Raw&
+  raw_data() const noexcept {
+    return data_;
+  }
+
+ private:
+  Raw data_{};
+};
+
+template<typename Raw>
+class basic_data<adc_stream_format::type2, Raw> {
+ public:
+  using value_type = decltype(std::declval<Raw>().val);
+  static constexpr const adc_stream_format format = adc_stream_format::type2;
+  static constexpr const adc_digi_output_format_t output_format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+  value_type channel() const noexcept {
+    return data_.type2.channel;
+  }
+
+  value_type value() const noexcept {
+    return data_.type2.data;
+  }
+
+  value_type unit() const noexcept {
+    return data_.type2.unit;
+  }
+
+  bool is_valid(std::uint32_t unit) const noexcept {
+    return channel() < SOC_ADC_CHANNEL_NUM(unit);
+  }
+
+  Raw&
+  raw_data() noexcept {
+    return data_;
+  }
+
+  const Raw&
+  raw_data() const noexcept {
+    return data_;
+  }
+
+ private:
+  Raw data_{};
+};
+
+/**
+ * Format used by the compiled target
+ */
+static constexpr const adc_stream_format native_format =
+  resolve_format(compiled_mcu::ADC::continuous::format);
+
+using native_data = basic_data<native_format>;
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_DATA_HPP_
@@ -0,0 +1,170 @@
+/**
+ * @file demux.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Routes interleaved ADC records into per channel contiguous buffers
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * std::uint32_t voltage[256], current[256];
+ * uc::adc::demux<2, uc::adc::stream::data> dmx(ADC_UNIT_1,
+ *                       {ADC_CHANNEL_0, ADC_CHANNEL_3},
+ *                       {voltage, current});
+ * dmx(data, result.readed);
+ * auto v = dmx.channel(0);   // std::span with the samples of ADC_CHANNEL_0
+ * ...
+ * dmx.clear();
+ */
+#ifndef COMPONENTS_UC_ADC_DEMUX_HPP_
+#define COMPONENTS_UC_ADC_DEMUX_HPP_
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <span>
+
+#include "uc/adc/backend.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * Demultiplexer of the records returned by a backend read() (Data is its
+ * data type, e.g. uc::adc::stream::data or uc::adc::sample).
+ *
+ * Each record is validated and its value appended to the buffer of its
+ * channel, in one pass. Buffers are user provided, and keep filling across
+ * calls until clear(). Records that can't be stored are counted as:
+ * - invalid: is_valid() failed (corrupted record);
+ * - unmapped: valid channel not configured at the demux;
+ * - overflow: channel buffer full.
+ */
+template<std::size_t Channels, record Data>
+class demux {
+ public:
+  using data = Data;
+  using value_type = typename Data::value_type;
+  using span_type = std::span<value_type>;
+  using buffers_type = std::array<span_type, Channels>;
+  using channels_type = std::array<std::uint32_t, Channels>;
+
+  static_assert(Channels > 0, "At least one channel must be defined");
+
+  static constexpr const std::size_t max_channels = 16;   // 4 bits channel field
+  static constexpr const std::uint8_t no_index = 0xFF;
+
+  struct drops {
+    std::size_t invalid = 0;
+    std::size_t unmapped = 0;
+    std::size_t overflow = 0;
+
+    [[nodiscard]] constexpr std::size_t
+    total() const noexcept {
+      return invalid + unmapped + overflow;
+    }
+  };
+
+  /**
+   * 'channels[i]' (ADC channel number) is routed to 'buffers[i]'
+   */
+  constexpr
+  demux(std::uint32_t unit,
+        const channels_type& channels,
+        const buffers_type& buffers) noexcept
+   : unit_(unit), channels_(channels), buffers_(buffers) {
+    index_.fill(no_index);
+    for (std::size_t i = 0; i < Channels; ++i)
+      if (channels[i] < max_channels)
+        index_[channels[i]] = static_cast<std::uint8_t>(i);
+  }
+
+  /**
+   * Routes 'size' records. Returns the number of samples stored.
+   */
+  std::size_t
+  operator()(const data* records, std::size_t size) noexcept {
+    std::size_t stored = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      const data& d = records[i];
+      if (!d.is_valid(unit_)) {
+        ++drops_.invalid;
+        continue;
+      }
+
+      auto const ch = static_cast<std::size_t>(d.channel());
+      std::uint8_t const index = ch < max_channels ? index_[ch] : no_index;
+      if (index == no_index) {
+        ++drops_.unmapped;
+        continue;
+      }
+
+      std::size_t& fill = fill_[index];
+      if (fill == buffers_[index].size()) {
+        ++drops_.overflow;
+        continue;
+      }
+      buffers_[index][fill++] = d.value();
+      ++stored;
+    }
+    return stored;
+  }
+
+  /**
+   * Samples stored of the i-th channel
+   */
+  [[nodiscard]] constexpr span_type
+  channel(std::size_t i) const noexcept {
+    return buffers_[i].first(fill_[i]);
+  }
+
+  /**
+   * ADC channel number of the i-th channel
+   */
+  [[nodiscard]] constexpr std::uint32_t
+  channel_number(std::size_t i) const noexcept {
+    return channels_[i];
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  size(std::size_t i) const noexcept {
+    return fill_[i];
+  }
+
+  [[nodiscard]] constexpr bool
+  full(std::size_t i) const noexcept {
+    return fill_[i] == buffers_[i].size();
+  }
+
+  [[nodiscard]] constexpr const drops&
+  dropped() const noexcept {
+    return drops_;
+  }
+
+  /**
+   * Empties the buffers (drop counters are kept)
+   */
+  constexpr void
+  clear() noexcept {
+    fill_ = {};
+  }
+
+  constexpr void
+  reset_drops() noexcept {
+    drops_ = {};
+  }
+
+ private:
+  std::uint32_t                             unit_;
+  channels_type                             channels_;
+  buffers_type                              buffers_;
+  std::array<std::uint8_t, max_channels>    index_{};
+  std::array<std::size_t, Channels>         fill_{};
+  drops                                     drops_{};
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_DEMUX_HPP_
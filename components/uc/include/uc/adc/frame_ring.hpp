@@ -0,0 +1,198 @@
+/**
+ * @file frame_ring.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC conversion frames handed from the ISR to a task without
+ *        the backend read()
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * static uc::adc::frame_ring<uc::adc::stream, 4, EXAMPLE_READ_LEN_BYTES> ring;
+ * ring.attach(adc);
+ * adc.start();
+ * while (true) {
+ *   auto frame = ring.acquire(sys::time::max);
+ *   process(frame.data(), frame.size());
+ *   ring.release();
+ * }
+ */
+#ifndef COMPONENTS_UC_ADC_FRAME_RING_HPP_
+#define COMPONENTS_UC_ADC_FRAME_RING_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <array>
+#include <atomic>
+#include <span>
+
+#include "esp_attr.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sys/error.hpp"
+#include "sys/time.hpp"
+
+#include "uc/adc/backend.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * Single producer (the on_conv_done ISR) / single consumer ring of Frames
+ * preallocated frames of FrameSize bytes (the backend conv_frame_size).
+ *
+ * The ISR copies the just converted DMA frame into the next free slot and
+ * publishes it; the consumer borrows the oldest slot in place and returns
+ * it with release(). This doesn't save a copy: the driver still copies
+ * DMA -> pool before calling on_conv_done, and the ISR copies DMA -> slot,
+ * so each frame is still copied twice, one of them in ISR context. What
+ * changes is that the consumer is not blocked at stream::read, and doesn't
+ * need a buffer of its own.
+ *
+ * The pool is never read in this mode: configure uc::adc::stream with
+ * 'flush_pool = true'. If the consumer doesn't release slots in time, new
+ * frames are dropped and counted at overruns(). Frames larger than FrameSize
+ * are cut to fit and counted at truncated().
+ */
+template<backend Backend, std::size_t Frames, std::size_t FrameSize>
+class frame_ring {
+ public:
+  using backend_type = Backend;
+  using data = typename Backend::data;
+  using span_type = std::span<const data>;
+  static constexpr const std::size_t frames = Frames;
+  static constexpr const std::size_t frame_size = FrameSize;
+  static constexpr const std::size_t frame_samples = FrameSize / sizeof(data);
+
+  static_assert(Frames >= 2 && (Frames & (Frames - 1)) == 0,
+                "Frames must be a power of 2 greater than 1");
+  static_assert(FrameSize % sizeof(data) == 0,
+                "Frame size must be a multiple of the conversion size");
+
+  frame_ring() noexcept = default;
+  frame_ring(const frame_ring&) = delete;
+  frame_ring& operator=(const frame_ring&) = delete;
+
+  /**
+   * Registers the ring as the backend event handler. 'consumer' is notified
+   * (task notification) at every published frame.
+   */
+  sys::error
+  attach(Backend& adc,
+         TaskHandle_t consumer = xTaskGetCurrentTaskHandle()) noexcept {
+    consumer_ = consumer;
+    return adc.register_handler({
+      .on_conv_done = on_conv_done,
+      .on_pool_ovf = nullptr
+    }, this);
+  }
+
+  /**
+   * Oldest published frame, waiting up to 'wait' for one. Empty span on
+   * timeout. The frame is valid until release().
+   */
+  template<sys::time::tick_time Wait = sys::time::ticks>
+  [[nodiscard]] span_type
+  acquire(Wait wait = 0) noexcept {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    while (head_.load(std::memory_order_acquire) == tail) {
+      if (ulTaskNotifyTake(pdTRUE, sys::time::to_ticks(wait)) == 0)
+        return {};
+    }
+    auto const& slot = slots_[tail & mask];
+    return {slot.frame.data(), slot.size};
+  }
+
+  /**
+   * Returns the frame borrowed by acquire() to the ring
+   */
+  void release() noexcept {
+    assert(pending() != 0 && "No frame acquired");
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  /**
+   * Published frames not yet released
+   */
+  [[nodiscard]] std::size_t
+  pending() const noexcept {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Frames dropped because the ring was full
+   */
+  [[nodiscard]] std::uint32_t
+  overruns() const noexcept {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Frames larger than FrameSize, published cut to fit
+   */
+  [[nodiscard]] std::uint32_t
+  truncated() const noexcept {
+    return truncated_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using handler = typename Backend::handler;
+  using event_data = typename Backend::event_data;
+
+  static constexpr const std::uint32_t mask = Frames - 1;
+
+  struct slot {
+    std::array<data, frame_samples> frame;
+    std::size_t                     size;     // samples
+  };
+
+  static bool IRAM_ATTR
+  on_conv_done(handler,
+               const event_data* edata,
+               void* user_data) {
+    auto* self = static_cast<frame_ring*>(user_data);
+    return self->publish(edata->conv_frame_buffer, edata->size);
+  }
+
+  bool IRAM_ATTR
+  publish(const std::uint8_t* buffer, std::uint32_t size) noexcept {
+    auto const head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == Frames) {
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    auto& s = slots_[head & mask];
+    if (size > FrameSize) {
+      truncated_.fetch_add(1, std::memory_order_relaxed);
+      size = FrameSize;
+    }
+    std::memcpy(s.frame.data(), buffer, size);
+    s.size = size / sizeof(data);
+    head_.store(head + 1, std::memory_order_release);
+
+    BaseType_t must_yield = pdFALSE;
+    if (consumer_)
+      vTaskNotifyGiveFromISR(consumer_, &must_yield);
+    return must_yield == pdTRUE;
+  }
+
+  std::array<slot, Frames>    slots_{};
+  std::atomic<std::uint32_t>  head_{0};
+  std::atomic<std::uint32_t>  tail_{0};
+  std::atomic<std::uint32_t>  overruns_{0};
+  std::atomic<std::uint32_t>  truncated_{0};
+  TaskHandle_t                consumer_ = nullptr;
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_FRAME_RING_HPP_
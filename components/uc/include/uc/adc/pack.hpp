@@ -0,0 +1,258 @@
+/**
+ * @file pack.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Compact binary encodings of ADC samples for streaming
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * std::uint8_t buffer[sizeof(uc::adc::packed_header) + uc::adc::packed12_size(256)];
+ * std::size_t size = uc::adc::pack(uc::adc::encoding::packed12,
+ *                                  sequence++, ADC_CHANNEL_0,
+ *                                  samples.begin(), samples.end(),
+ *                                  buffer);
+ *
+ * Encodings (all little endian):
+ * - raw16: 2 bytes per sample;
+ * - packed12: 2 samples in 3 bytes, s0[7:0] | s0[11:8] s1[3:0] | s1[11:4].
+ *   A odd last sample uses 2 bytes. Only the 12 lower bits are kept;
+ * - delta: difference to the previous sample (the first to 0), zigzag
+ *   mapped and written as LEB128 varint. Slow signals use ~1 byte per
+ *   sample; worst case (16 bits samples) is 3 bytes.
+ *
+ * Samples can be values or records (value() is used, as stream::data).
+ */
+#ifndef COMPONENTS_UC_ADC_PACK_HPP_
+#define COMPONENTS_UC_ADC_PACK_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+namespace uc {
+namespace adc {
+
+enum class encoding : std::uint8_t {
+  raw16     = 0,
+  packed12  = 1,
+  delta     = 2
+};
+
+/**
+ * Precedes the samples at pack()
+ */
+struct packed_header {
+  std::uint32_t sequence;
+  std::uint16_t count;        // Samples (up to 65535 per packet)
+  std::uint8_t  channel;
+  encoding      format;
+};
+
+static_assert(sizeof(packed_header) == 8);
+
+[[nodiscard]] constexpr std::size_t
+packed12_size(std::size_t count) noexcept {
+  return (count * 3 + 1) / 2;
+}
+
+[[nodiscard]] constexpr std::size_t
+delta_max_size(std::size_t count) noexcept {
+  return count * 3;
+}
+
+[[nodiscard]] constexpr std::size_t
+max_size(encoding enc, std::size_t count) noexcept {
+  switch (enc) {
+    case encoding::raw16: return count * 2;
+    case encoding::packed12: return packed12_size(count);
+    case encoding::delta: return delta_max_size(count);
+  }
+  return 0;
+}
+
+namespace detail {
+
+template<typename T>
+constexpr std::uint32_t
+sample_value(const T& sample) noexcept {
+  if constexpr (std::is_class_v<T>)
+    return static_cast<std::uint32_t>(sample.value());
+  else
+    return static_cast<std::uint32_t>(sample);
+}
+
+constexpr std::uint32_t
+zigzag(std::int32_t value) noexcept {
+  return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+constexpr std::int32_t
+unzigzag(std::uint32_t value) noexcept {
+  return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+}
+
+}  // namespace detail
+
+/**
+ * Returns the bytes written, 0 if 'out' is too small
+ */
+template<typename Iter>
+std::size_t
+pack_raw16(Iter begin, Iter end, std::span<std::uint8_t> out) noexcept {
+  std::size_t size = 0;
+  for (; begin != end; ++begin) {
+    if (size + 2 > out.size())
+      return 0;
+    auto const v = detail::sample_value(*begin);
+    out[size++] = static_cast<std::uint8_t>(v);
+    out[size++] = static_cast<std::uint8_t>(v >> 8);
+  }
+  return size;
+}
+
+template<typename Iter>
+std::size_t
+pack12(Iter begin, Iter end, std::span<std::uint8_t> out) noexcept {
+  std::size_t size = 0;
+  while (begin != end) {
+    auto const s0 = detail::sample_value(*begin++) & 0xFFF;
+    if (begin == end) {
+      if (size + 2 > out.size())
+        return 0;
+      out[size++] = static_cast<std::uint8_t>(s0);
+      out[size++] = static_cast<std::uint8_t>(s0 >> 8);
+      break;
+    }
+    auto const s1 = detail::sample_value(*begin++) & 0xFFF;
+    if (size + 3 > out.size())
+      return 0;
+    out[size++] = static_cast<std::uint8_t>(s0);
+    out[size++] = static_cast<std::uint8_t>((s0 >> 8) | (s1 << 4));
+    out[size++] = static_cast<std::uint8_t>(s1 >> 4);
+  }
+  return size;
+}
+
+template<typename Iter>
+std::size_t
+pack_delta(Iter begin, Iter end, std::span<std::uint8_t> out) noexcept {
+  std::size_t size = 0;
+  std::int32_t prev = 0;
+  for (; begin != end; ++begin) {
+    auto const v = static_cast<std::int32_t>(detail::sample_value(*begin));
+    std::uint32_t z = detail::zigzag(v - prev);
+    prev = v;
+    do {
+      if (size == out.size())
+        return 0;
+      std::uint8_t const byte = z & 0x7F;
+      z >>= 7;
+      out[size++] = z ? (byte | 0x80) : byte;
+    } while (z);
+  }
+  return size;
+}
+
+/**
+ * Header and encoded samples. Returns the bytes written, 0 if 'out' is too
+ * small or there are more samples than the header count holds (65535).
+ */
+template<typename Iter>
+std::size_t
+pack(encoding enc,
+     std::uint32_t sequence,
+     std::uint8_t channel,
+     Iter begin, Iter end,
+     std::span<std::uint8_t> out) noexcept {
+  auto const count = std::distance(begin, end);
+  if (out.size() < sizeof(packed_header) || count > UINT16_MAX)
+    return 0;
+
+  auto const payload = out.subspan(sizeof(packed_header));
+  std::size_t size = 0;
+  switch (enc) {
+    case encoding::raw16:
+      size = pack_raw16(begin, end, payload);
+      break;
+    case encoding::packed12:
+      size = pack12(begin, end, payload);
+      break;
+    case encoding::delta:
+      size = pack_delta(begin, end, payload);
+      break;
+  }
+  if (size == 0 && begin != end)
+    return 0;
+
+  packed_header const header{
+    sequence,
+    static_cast<std::uint16_t>(count),
+    channel,
+    enc
+  };
+  std::memcpy(out.data(), &header, sizeof(header));
+  return sizeof(header) + size;
+}
+
+/**
+ * Decoders (host side / tests). Return the bytes consumed, 0 if 'in' is
+ * truncated.
+ */
+template<typename OutIter>
+std::size_t
+unpack_raw16(std::span<const std::uint8_t> in, std::size_t count, OutIter out) noexcept {
+  if (in.size() < count * 2)
+    return 0;
+  for (std::size_t i = 0; i < count; ++i)
+    *out++ = static_cast<std::uint16_t>(in[2 * i] | (in[2 * i + 1] << 8));
+  return count * 2;
+}
+
+template<typename OutIter>
+std::size_t
+unpack12(std::span<const std::uint8_t> in, std::size_t count, OutIter out) noexcept {
+  std::size_t const size = packed12_size(count);
+  if (in.size() < size)
+    return 0;
+  std::size_t i = 0;
+  for (; count >= 2; count -= 2, i += 3) {
+    *out++ = static_cast<std::uint16_t>(in[i] | ((in[i + 1] & 0x0F) << 8));
+    *out++ = static_cast<std::uint16_t>((in[i + 1] >> 4) | (in[i + 2] << 4));
+  }
+  if (count)
+    *out++ = static_cast<std::uint16_t>(in[i] | ((in[i + 1] & 0x0F) << 8));
+  return size;
+}
+
+template<typename OutIter>
+std::size_t
+unpack_delta(std::span<const std::uint8_t> in, std::size_t count, OutIter out) noexcept {
+  std::size_t i = 0;
+  std::int32_t prev = 0;
+  while (count--) {
+    std::uint32_t z = 0;
+    unsigned shift = 0;
+    while (true) {
+      if (i == in.size() || shift > 28)
+        return 0;
+      std::uint8_t const byte = in[i++];
+      z |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+      shift += 7;
+      if (!(byte & 0x80))
+        break;
+    }
+    prev += detail::unzigzag(z);
+    *out++ = static_cast<std::uint16_t>(prev);
+  }
+  return i;
+}
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_PACK_HPP_
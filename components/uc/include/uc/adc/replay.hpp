@@ -0,0 +1,403 @@
+/**
+ * @file replay.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Host (Linux) ADC continuous backend: replays recorded files or
+ *        generates synthetic waveforms
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * uc::adc::waveform<> wf(20000, {
+ *   {.number = 0, .offset = 2048, .amplitude = 1000, .frequency = 60},
+ *   {.number = 3, .offset = 2048, .amplitude = 500, .frequency = 60}
+ * });
+ * uc::adc::replay<> adc({.max_store_buf_size = 4096, .conv_frame_size = 256},
+ *                       uc::adc::waveform<>::read, &wf);
+ * adc.configure({.sample_freq_hz = 20000, .speed = 10});
+ * adc.register_handler({.on_conv_done = conv_done}, &consumer);
+ * adc.start();
+ * ...
+ * adc.read(data, size, 0);
+ *
+ * Mirrors uc::adc::stream (see uc/adc/backend.hpp): frames are produced at
+ * a thread, paced at 'sample_freq_hz' times 'speed' (0: as fast as
+ * possible), stored at a pool of 'max_store_buf_size' bytes and signaled
+ * by on_conv_done. If the pool can't hold a frame, the frame is discarded
+ * and on_pool_ovf called. Callbacks run at the producer thread, as the ISR
+ * at the board.
+ *
+ * Only uses the standard library and sys/error.hpp (esp_err.h).
+ */
+#ifndef COMPONENTS_UC_ADC_REPLAY_HPP_
+#define COMPONENTS_UC_ADC_REPLAY_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cmath>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <initializer_list>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sys/error.hpp"
+
+#include "uc/adc/backend.hpp"
+
+namespace uc {
+namespace adc {
+
+/**
+ * Host record
+ */
+struct sample {
+  using value_type = std::uint32_t;
+
+  std::uint16_t number;
+  std::uint16_t data;
+
+  [[nodiscard]] constexpr value_type
+  channel() const noexcept {
+    return number;
+  }
+
+  [[nodiscard]] constexpr value_type
+  value() const noexcept {
+    return data;
+  }
+
+  [[nodiscard]] constexpr bool
+  is_valid(std::uint32_t) const noexcept {
+    return number < 16;
+  }
+};
+
+template<typename Data = sample>
+class replay {
+ public:
+  using data = Data;
+  using handler = replay*;
+
+  struct event_data {
+    std::uint8_t*   conv_frame_buffer;
+    std::uint32_t   size;
+  };
+
+  using event_callback = bool(*)(handler, const event_data*, void*);
+
+  struct callback {
+    event_callback on_conv_done = nullptr;
+    event_callback on_pool_ovf = nullptr;
+  };
+
+  struct result {
+    std::uint32_t readed;
+    sys::error    error;
+
+    constexpr
+    operator bool() const noexcept {
+      return !(bool)error;
+    }
+  };
+
+  struct config {
+    std::uint32_t max_store_buf_size;   // Bytes
+    std::uint32_t conv_frame_size;      // Bytes
+  };
+
+  struct continuous_config {
+    std::uint32_t sample_freq_hz;
+    double        speed = 1;            // Real time multiplier. 0: no pacing
+  };
+
+  /**
+   * Fills up to 'size' records. Returns the number filled, 0 at the end.
+   */
+  using source = std::size_t(*)(data*, std::size_t, void*);
+
+  replay(const config& cfg, source src, void* arg = nullptr) noexcept
+   : pool_(std::max<std::size_t>(cfg.max_store_buf_size / sizeof(data), 1)),
+     frame_(std::max<std::size_t>(cfg.conv_frame_size / sizeof(data), 1)),
+     src_(src), arg_(arg) {}
+  replay(const replay&) = delete;
+  replay& operator=(const replay&) = delete;
+
+  ~replay() noexcept {
+    stop();
+  }
+
+  [[nodiscard]] bool
+  is_initiated() const noexcept {
+    return src_ != nullptr;
+  }
+
+  sys::error configure(const continuous_config& cfg) noexcept {
+    if (running_.load(std::memory_order_acquire))
+      return ESP_ERR_INVALID_STATE;
+    if (cfg.sample_freq_hz == 0 || cfg.speed < 0)
+      return ESP_ERR_INVALID_ARG;
+    cfg_ = cfg;
+    return ESP_OK;
+  }
+
+  sys::error register_handler(const callback& cb, void* arg = nullptr) noexcept {
+    if (running_.load(std::memory_order_acquire))
+      return ESP_ERR_INVALID_STATE;
+    cb_ = cb;
+    user_data_ = arg;
+    return ESP_OK;
+  }
+
+  sys::error start() noexcept {
+    if (running_.exchange(true, std::memory_order_acq_rel))
+      return ESP_ERR_INVALID_STATE;
+    finished_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&replay::produce, this);
+    return ESP_OK;
+  }
+
+  sys::error stop() noexcept {
+    if (!running_.exchange(false, std::memory_order_acq_rel))
+      return ESP_OK;
+    cv_.notify_all();
+    if (thread_.joinable())
+      thread_.join();
+    return ESP_OK;
+  }
+
+  /**
+   * Waits up to 'timeout_ms' for the first record
+   */
+  result read(data* dt, std::size_t size, std::uint32_t timeout_ms) noexcept {
+    std::unique_lock lock(mtx_);
+    if (count_ == 0 && timeout_ms != 0)
+      cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] {
+        return count_ != 0 || !running_.load(std::memory_order_relaxed);
+      });
+    if (count_ == 0)
+      return {0, ESP_ERR_TIMEOUT};
+
+    std::size_t const n = std::min(size, count_);
+    std::size_t const first = std::min(n, pool_.size() - tail_);
+    std::copy_n(pool_.begin() + tail_, first, dt);
+    std::copy_n(pool_.begin(), n - first, dt + first);
+    tail_ = (tail_ + n) % pool_.size();
+    count_ -= n;
+    return {static_cast<std::uint32_t>(n), ESP_OK};
+  }
+
+  template<typename Rep, typename Ratio>
+  result read(data* dt, std::size_t size,
+              std::chrono::duration<Rep, Ratio> duration) noexcept {
+    return read(dt, size, static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()));
+  }
+
+  [[nodiscard]] bool
+  is_running() const noexcept {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Source returned 0: no more frames will be produced
+   */
+  [[nodiscard]] bool
+  finished() const noexcept {
+    return finished_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] std::uint32_t
+  frames() const noexcept {
+    return frames_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint32_t
+  pool_overflows() const noexcept {
+    return overflows_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void produce() noexcept {
+    using clock = std::chrono::steady_clock;
+    std::vector<data> frame(frame_);
+    auto next = clock::now();
+
+    while (running_.load(std::memory_order_acquire)) {
+      std::size_t const n = src_(frame.data(), frame.size(), arg_);
+      if (n == 0) {
+        finished_.store(true, std::memory_order_release);
+        cv_.notify_all();
+        break;
+      }
+
+      event_data ev{reinterpret_cast<std::uint8_t*>(frame.data()),
+                    static_cast<std::uint32_t>(n * sizeof(data))};
+      if (store(frame.data(), n)) {
+        frames_.fetch_add(1, std::memory_order_relaxed);
+        cv_.notify_all();
+        if (cb_.on_conv_done)
+          cb_.on_conv_done(this, &ev, user_data_);
+      } else {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        if (cb_.on_pool_ovf)
+          cb_.on_pool_ovf(this, &ev, user_data_);
+      }
+
+      if (cfg_.speed > 0) {
+        next += std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>(n / (cfg_.sample_freq_hz * cfg_.speed)));
+        std::unique_lock lock(mtx_);
+        cv_.wait_until(lock, next, [this] {
+          return !running_.load(std::memory_order_relaxed);
+        });
+      }
+    }
+  }
+
+  bool store(const data* dt, std::size_t n) noexcept {
+    std::lock_guard lock(mtx_);
+    if (pool_.size() - count_ < n)
+      return false;
+    std::size_t const head = (tail_ + count_) % pool_.size();
+    std::size_t const first = std::min(n, pool_.size() - head);
+    std::copy_n(dt, first, pool_.begin() + head);
+    std::copy_n(dt + first, n - first, pool_.begin());
+    count_ += n;
+    return true;
+  }
+
+  std::vector<data>           pool_;
+  std::size_t                 tail_ = 0;
+  std::size_t                 count_ = 0;
+  std::size_t                 frame_;
+
+  source                      src_;
+  void*                       arg_;
+  continuous_config           cfg_{1000};
+  callback                    cb_{};
+  void*                       user_data_ = nullptr;
+
+  std::thread                 thread_;
+  std::mutex                  mtx_;
+  std::condition_variable     cv_;
+  std::atomic<bool>           running_{false};
+  std::atomic<bool>           finished_{false};
+  std::atomic<std::uint32_t>  frames_{0};
+  std::atomic<std::uint32_t>  overflows_{0};
+};
+
+static_assert(backend<replay<>>);
+
+/**
+ * Synthetic source. Channels are sampled in turn (as a pattern), one
+ * record per conversion at 'sample_freq'. Values are clamped to 'bits'.
+ * Data must be constructible as Data{channel, value}.
+ */
+template<typename Data = sample>
+class waveform {
+ public:
+  struct channel {
+    std::uint32_t number = 0;
+    double        offset = 2048;
+    double        amplitude = 1000;
+    double        frequency = 60;
+    double        phase = 0;
+    double        noise = 0;      // Standard deviation
+  };
+
+  waveform(double sample_freq,
+           std::initializer_list<channel> channels,
+           std::size_t length = 0,          // Records, 0: endless
+           unsigned bits = 12,
+           unsigned seed = 42) noexcept
+   : channels_(channels), sample_freq_(sample_freq), length_(length),
+     max_((1u << bits) - 1), gen_(seed) {}
+
+  static std::size_t
+  read(Data* dt, std::size_t size, void* arg) noexcept {
+    auto* self = static_cast<waveform*>(arg);
+    if (self->length_ != 0)
+      size = std::min(size, self->length_ - self->index_);
+    for (std::size_t i = 0; i < size; ++i)
+      dt[i] = self->next();
+    return size;
+  }
+
+  [[nodiscard]] std::size_t
+  generated() const noexcept {
+    return index_;
+  }
+
+ private:
+  Data next() noexcept {
+    channel const& ch = channels_[index_ % channels_.size()];
+    double const t = static_cast<double>(index_++) / sample_freq_;
+    double v = ch.offset + ch.amplitude * std::sin(2 * M_PI * ch.frequency * t + ch.phase);
+    if (ch.noise > 0)
+      v += ch.noise * dist_(gen_);
+    auto const value = static_cast<std::uint32_t>(
+      std::clamp<long>(std::lround(v), 0, static_cast<long>(max_)));
+    return Data{static_cast<std::uint16_t>(ch.number),
+                static_cast<std::uint16_t>(value)};
+  }
+
+  std::vector<channel>              channels_;
+  double                            sample_freq_;
+  std::size_t                       length_;
+  std::uint32_t                     max_;
+  std::size_t                       index_ = 0;
+  std::mt19937                      gen_;
+  std::normal_distribution<double>  dist_{0, 1};
+};
+
+/**
+ * Recorded source: file of raw Data records, as written by
+ * fwrite(data, sizeof(Data), size, fp) from the read() buffers.
+ */
+template<typename Data = sample>
+class file_source {
+ public:
+  file_source(const char* path, bool loop = false) noexcept
+   : fp_(std::fopen(path, "rb")), loop_(loop) {}
+  file_source(const file_source&) = delete;
+  file_source& operator=(const file_source&) = delete;
+
+  ~file_source() noexcept {
+    if (fp_)
+      std::fclose(fp_);
+  }
+
+  [[nodiscard]] bool
+  is_open() const noexcept {
+    return fp_ != nullptr;
+  }
+
+  static std::size_t
+  read(Data* dt, std::size_t size, void* arg) noexcept {
+    auto* self = static_cast<file_source*>(arg);
+    if (!self->fp_)
+      return 0;
+    std::size_t n = std::fread(dt, sizeof(Data), size, self->fp_);
+    if (n == 0 && self->loop_) {
+      std::rewind(self->fp_);
+      n = std::fread(dt, sizeof(Data), size, self->fp_);
+    }
+    return n;
+  }
+
+ private:
+  std::FILE*  fp_;
+  bool        loop_;
+};
+
+}  // namespace adc
+}  // namespace uc
+
+#endif  // COMPONENTS_UC_ADC_REPLAY_HPP_
@@ -12,6 +12,8 @@
 #define COMPONENTS_UC_ADC_STREAM_HPP_
 
 #include <cstdint>
+#include <climits>
+#include <atomic>
 #include <utility>
 
 #include "esp_adc/adc_continuous.h"
@@ -19,6 +21,9 @@
 #include "sys/error.hpp"
 #include "sys/time.hpp"
 
+#include "uc/adc/backend.hpp"
+#include "uc/adc/data.hpp"
+
 namespace uc {
 namespace adc {
 
@@ -28,50 +33,11 @@ class stream {
   using config = adc_continuous_handle_cfg_t;
   using continuous_config = adc_continuous_config_t;
   using callback = adc_continuous_evt_cbs_t;
+  using event_data = adc_continuous_evt_data_t;
   using pattern = adc_digi_pattern_config_t;
 
-  class data {
-   public:
-    using value_type = decltype(std::declval<adc_digi_output_data_t>().val);
-
-#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
-    value_type channel() const noexcept {
-      return data_.type1.channel;
-    }
-
-    value_type value() const noexcept {
-      return data_.type1.data;
-    }
-#else
-    value_type channel() const noexcept {
-      return data_.type2.channel;
-    }
-
-    value_type value() const noexcept {
-      return data_.type2.data;
-    }
-
-    value_type unit() const noexcept {
-      return data_.type2.unit();
-    }
-#endif
-    bool is_valid(std::uint32_t unit) const noexcept {
-      return channel() < SOC_ADC_CHANNEL_NUM(unit);
-    }
-
-    adc_digi_output_data_t&
-    raw_data() noexcept {
-      return data_;
-    }
-
-    const adc_digi_output_data_t&
-    raw_data() const noexcept {
-      return data_;
-    }
-
-   private:
-    adc_digi_output_data_t data_{};
-  };
+  // Record of the compiled target format (see uc/adc/data.hpp)
+  using data = native_data;
 
   struct result {
     std::uint32_t readed;
@@ -83,15 +49,37 @@ class stream {
     }
   };
 
+  /**
+   * Snapshot of the stream counters. Times in microseconds.
+   */
+  struct statistics {
+    std::uint32_t frames;           // Conversion frames done
+    std::uint32_t bytes;            // Wraps at 4 GiB
+    std::uint32_t pool_overflows;   // Frames lost, driver pool full
+    std::uint32_t validate_invalid; // Invalid records found by validate() only
+    std::uint32_t max_latency;      // First frame ready to the read() return
+    std::uint32_t min_interval;     // Between frames
+    std::uint32_t max_interval;
+
+    [[nodiscard]] constexpr std::uint32_t
+    jitter() const noexcept {
+      return max_interval > min_interval ? max_interval - min_interval : 0;
+    }
+  };
+
   stream() noexcept = default;
   stream(const config& cfg) noexcept;
   stream(const stream&) noexcept = delete;
-  stream(stream&& adc) noexcept {
-    handler_ = adc.handler_;
-    adc.handler_ = nullptr;
-  }
+  /**
+   * The driver calls back the stream address, and only accepts a new one
+   * stopped: must be moved before start(). A started 'adc' is stopped (and
+   * asserts at debug builds). If the callbacks can't be registered to the
+   * new address the driver is released, and is_initiated() is false.
+   */
+  stream(stream&& adc) noexcept;
 
   bool is_initiated() const noexcept;
+  handler native_handle() const noexcept;
 
   sys::error init(const config&) noexcept;
   sys::error deinit() noexcept;
@@ -101,15 +89,30 @@ class stream {
 
   sys::error configure(const continuous_config&) noexcept;
 
+  /**
+   * User callbacks, called by the internal ones. Stopped only
+   * (ESP_ERR_INVALID_STATE).
+   */
   sys::error register_handler(const callback&, void* data = nullptr) noexcept;
 
   result read(data*, std::size_t, sys::time::ticks) noexcept;
+  result read(adc_digi_output_data_t*, std::size_t, sys::time::ticks) noexcept;
   template<typename Rep, typename Ratio>
   result read(data* dt, std::size_t size,
               std::chrono::duration<Rep, Ratio> duration) noexcept {
     return read(dt, size, sys::time::to_ticks(duration));
   }
 
+  /**
+   * Counts records not valid for 'unit' (see statistics::validate_invalid).
+   * Returns the number of invalid records.
+   */
+  std::uint32_t validate(const data*, std::size_t, std::uint32_t unit) noexcept;
+
+  [[nodiscard]] statistics
+  stats() const noexcept;
+  void reset_stats() noexcept;
+
   static handler
   initiate(const config& cfg) noexcept;
 
@@ -118,9 +121,36 @@ class stream {
     deinit();
   }
  private:
+  /**
+   * Internal ISR callbacks: update the counters and call the user ones
+   */
+  static bool on_conv_done(handler,
+                           const adc_continuous_evt_data_t*,
+                           void*) noexcept;
+  static bool on_pool_ovf(handler,
+                          const adc_continuous_evt_data_t*,
+                          void*) noexcept;
+  sys::error register_internal() noexcept;
+  void move_stats(const stream&) noexcept;
+
   handler handler_ = nullptr;
+  bool started_ = false;
+  callback user_cb_{};
+  void* user_data_ = nullptr;
+
+  std::atomic<std::uint32_t> frames_{0};
+  std::atomic<std::uint32_t> bytes_{0};
+  std::atomic<std::uint32_t> pool_overflows_{0};
+  std::atomic<std::uint32_t> validate_invalid_{0};
+  std::atomic<std::uint32_t> max_latency_{0};
+  std::atomic<std::uint32_t> min_interval_{UINT32_MAX};
+  std::atomic<std::uint32_t> max_interval_{0};
+  std::atomic<std::uint32_t> last_frame_{0};
+  std::atomic<std::uint32_t> pending_since_{0};   // 0: nothing pending
 };
 
+static_assert(backend<stream>);
+
 }  // namespace adc
 }  // namespace uc
 
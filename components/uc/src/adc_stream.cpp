@@ -9,7 +9,10 @@
  * 
  */
 #include <cassert>
+#include <atomic>
 
+#include "esp_attr.h"
+#include "esp_timer.h"
 #include "esp_adc/adc_continuous.h"
 
 #include "sys/error.hpp"
@@ -20,23 +23,69 @@
 namespace uc {
 namespace adc {
 
+namespace {
+
+std::uint32_t IRAM_ATTR
+now_us() noexcept {
+  return static_cast<std::uint32_t>(esp_timer_get_time());
+}
+
+void IRAM_ATTR
+update_max(std::atomic<std::uint32_t>& value, std::uint32_t sample) noexcept {
+  auto current = value.load(std::memory_order_relaxed);
+  while (sample > current &&
+         !value.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {}
+}
+
+void IRAM_ATTR
+update_min(std::atomic<std::uint32_t>& value, std::uint32_t sample) noexcept {
+  auto current = value.load(std::memory_order_relaxed);
+  while (sample < current &&
+         !value.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {}
+}
+
+}  // namespace
+
 stream::stream(const config& cfg) noexcept {
   init(cfg);
 }
 
+stream::stream(stream&& adc) noexcept
+ : handler_(adc.handler_),
+   user_cb_(adc.user_cb_),
+   user_data_(adc.user_data_) {
+  assert(!adc.started_ && "Started stream can't be moved");
+  if (adc.started_)
+    adc.stop();
+  adc.handler_ = nullptr;
+  move_stats(adc);
+  if (handler_ && register_internal()) {
+    // The ISR would still call 'adc'
+    adc_continuous_deinit(handler_);
+    handler_ = nullptr;
+  }
+}
+
 bool
 stream::is_initiated() const noexcept {
   return handler_ != nullptr;
 }
 
+stream::handler
+stream::native_handle() const noexcept {
+  return handler_;
+}
+
 sys::error
 stream::init(const config& cfg) noexcept {
   assert(handler_ == nullptr && "ADC already initated");
 
   auto ret = adc_continuous_new_handle(&cfg, &handler_);
-  if (ret)
+  if (ret) {
     handler_ = nullptr;
-  return ret;
+    return ret;
+  }
+  return register_internal();
 }
 
 sys::error stream::deinit() noexcept {
@@ -51,7 +100,10 @@ sys::error stream::deinit() noexcept {
 sys::error
 stream::start() noexcept {
   assert(handler_ != nullptr && "ADC NOT initated");
-  return adc_continuous_start(handler_);
+  auto ret = adc_continuous_start(handler_);
+  if (!ret)
+    started_ = true;
+  return ret;
 }
 
 sys::error
@@ -59,7 +111,10 @@ stream::stop() noexcept {
   if (handler_ == nullptr)
     return ESP_OK;
 
-  return adc_continuous_stop(handler_);
+  auto ret = adc_continuous_stop(handler_);
+  if (!ret)
+    started_ = false;
+  return ret;
 }
 
 sys::error
@@ -72,19 +127,132 @@ sys::error
 stream::register_handler(const callback& cb,
                                  void* data /* = nullptr */) noexcept {
   assert(handler_ != nullptr && "ADC NOT initated");
-  return adc_continuous_register_event_callbacks(handler_, &cb, data);
+  // The ISR reads the user callbacks
+  if (started_)
+    return ESP_ERR_INVALID_STATE;
+  user_cb_ = cb;
+  user_data_ = data;
+  return register_internal();
+}
+
+sys::error
+stream::register_internal() noexcept {
+  callback cb{
+    .on_conv_done = on_conv_done,
+    .on_pool_ovf = on_pool_ovf
+  };
+  return adc_continuous_register_event_callbacks(handler_, &cb, this);
+}
+
+bool IRAM_ATTR
+stream::on_conv_done(handler handle,
+                     const adc_continuous_evt_data_t* edata,
+                     void* arg) noexcept {
+  auto* self = static_cast<stream*>(arg);
+  auto const now = now_us() | 1;    // 0 is 'nothing pending'
+
+  auto const last = self->last_frame_.exchange(now, std::memory_order_relaxed);
+  if (self->frames_.fetch_add(1, std::memory_order_relaxed) != 0) {
+    update_max(self->max_interval_, now - last);
+    update_min(self->min_interval_, now - last);
+  }
+  self->bytes_.fetch_add(edata->size, std::memory_order_relaxed);
+  std::uint32_t idle = 0;
+  self->pending_since_.compare_exchange_strong(idle, now, std::memory_order_relaxed);
+
+  if (self->user_cb_.on_conv_done)
+    return self->user_cb_.on_conv_done(handle, edata, self->user_data_);
+  return false;
+}
+
+bool IRAM_ATTR
+stream::on_pool_ovf(handler handle,
+                    const adc_continuous_evt_data_t* edata,
+                    void* arg) noexcept {
+  auto* self = static_cast<stream*>(arg);
+  self->pool_overflows_.fetch_add(1, std::memory_order_relaxed);
+  if (self->user_cb_.on_pool_ovf)
+    return self->user_cb_.on_pool_ovf(handle, edata, self->user_data_);
+  return false;
 }
 
 stream::result
 stream::read(data* dt, std::size_t size, sys::time::ticks ticks) noexcept {
+  return read(&(dt->raw_data()), size, ticks);
+}
+
+stream::result
+stream::read(adc_digi_output_data_t* dt,
+             std::size_t size,
+             sys::time::ticks ticks) noexcept {
   assert(handler_ != nullptr && "ADC NOT initated");
   std::uint32_t num = 0;
   sys::error err = adc_continuous_read(handler_,
-                                       (std::uint8_t*)&(dt->raw_data()),
-                                       sizeof(data) * size,
+                                       (std::uint8_t*)dt,
+                                       sizeof(adc_digi_output_data_t) * size,
                                        &num,
                                        ticks);
-  return {num / sizeof(adc_digi_output_data_t), err};
+  if (!err) {
+    auto const since = pending_since_.exchange(0, std::memory_order_relaxed);
+    if (since != 0)
+      update_max(max_latency_, now_us() - since);
+  }
+  return {static_cast<std::uint32_t>(num / sizeof(adc_digi_output_data_t)), err};
+}
+
+std::uint32_t
+stream::validate(const data* dt,
+                 std::size_t size,
+                 std::uint32_t unit) noexcept {
+  std::uint32_t invalid = 0;
+  for (std::size_t i = 0; i < size; ++i)
+    invalid += !dt[i].is_valid(unit);
+  if (invalid)
+    validate_invalid_.fetch_add(invalid, std::memory_order_relaxed);
+  return invalid;
+}
+
+stream::statistics
+stream::stats() const noexcept {
+  auto const min_interval = min_interval_.load(std::memory_order_relaxed);
+  return {
+    .frames = frames_.load(std::memory_order_relaxed),
+    .bytes = bytes_.load(std::memory_order_relaxed),
+    .pool_overflows = pool_overflows_.load(std::memory_order_relaxed),
+    .validate_invalid = validate_invalid_.load(std::memory_order_relaxed),
+    .max_latency = max_latency_.load(std::memory_order_relaxed),
+    .min_interval = min_interval == UINT32_MAX ? 0 : min_interval,
+    .max_interval = max_interval_.load(std::memory_order_relaxed)
+  };
+}
+
+void
+stream::reset_stats() noexcept {
+  frames_ = 0;
+  bytes_ = 0;
+  pool_overflows_ = 0;
+  validate_invalid_ = 0;
+  max_latency_ = 0;
+  min_interval_ = UINT32_MAX;
+  max_interval_ = 0;
+}
+
+void
+stream::move_stats(const stream& adc) noexcept {
+  // 'adc' is stopped: no ISR updating it
+  auto const move = [](std::atomic<std::uint32_t>& to,
+                       const std::atomic<std::uint32_t>& from) {
+    to.store(from.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  };
+  move(frames_, adc.frames_);
+  move(bytes_, adc.bytes_);
+  move(pool_overflows_, adc.pool_overflows_);
+  move(validate_invalid_, adc.validate_invalid_);
+  move(max_latency_, adc.max_latency_);
+  move(min_interval_, adc.min_interval_);
+  move(max_interval_, adc.max_interval_);
+  move(last_frame_, adc.last_frame_);
+  move(pending_since_, adc.pending_since_);
 }
 
 stream::handler
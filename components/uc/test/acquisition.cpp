@@ -0,0 +1,235 @@
+/**
+ * @file acquisition.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Acquisition service, frame ring and demux over the replay backend
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "uc/adc/acquisition.hpp"
+#include "uc/adc/demux.hpp"
+#include "uc/adc/frame_ring.hpp"
+#include "uc/adc/replay.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+using replay = uc::adc::replay<>;
+using sample = uc::adc::sample;
+
+static constexpr const std::size_t buffer_samples = 1024;
+static constexpr const std::size_t buffers = 16;
+static constexpr const std::size_t length = buffers * buffer_samples;
+
+/**
+ * Channels 0 and 1 interleaved, both with the pair index as value
+ */
+struct counter {
+  std::size_t index = 0;
+  std::size_t length;
+
+  static std::size_t
+  read(sample* dt, std::size_t size, void* arg) noexcept {
+    auto* self = static_cast<counter*>(arg);
+    size = std::min(size, self->length - self->index);
+    for (std::size_t i = 0; i < size; ++i, ++self->index)
+      dt[i] = {static_cast<std::uint16_t>(self->index % 2),
+               static_cast<std::uint16_t>(self->index / 2)};
+    return size;
+  }
+};
+
+template<typename Predicate>
+static bool
+wait_for(Predicate&& pred, double seconds = 5) {
+  using clock = std::chrono::steady_clock;
+  auto const limit = clock::now() + std::chrono::duration_cast<clock::duration>(
+                                      std::chrono::duration<double>(seconds));
+  while (!pred()) {
+    if (clock::now() > limit)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+struct processed {
+  std::uint32_t               not_contiguous = 0;
+  std::uint32_t               unrouted = 0;
+  std::atomic<std::uint32_t>  calls{0};   // Last: the others are done
+};
+
+/**
+ * Each buffer demuxed: both channels must have the same consecutive values
+ */
+static void
+process(uc::adc::acquisition<replay>::span_type buffer, void* arg) {
+  auto& p = *static_cast<processed*>(arg);
+
+  std::uint32_t ch0[buffer_samples / 2], ch1[buffer_samples / 2];
+  uc::adc::demux<2, sample> dmx(0, {0, 1}, {ch0, ch1});
+  dmx(buffer.data(), buffer.size());
+  p.unrouted += dmx.dropped().total();
+
+  auto const v0 = dmx.channel(0), v1 = dmx.channel(1);
+  bool ok = v0.size() == buffer_samples / 2 && v1.size() == v0.size();
+  for (std::size_t i = 0; ok && i < v0.size(); ++i)
+    ok = v0[i] == v0[0] + i && v1[i] == v0[i];
+  p.not_contiguous += !ok;
+  p.calls.fetch_add(1, std::memory_order_release);
+}
+
+static void
+acquisition() {
+  counter src{.length = length};
+  // Pool holds the whole source: no pool overflow, even unpaced
+  replay adc({.max_store_buf_size = length * sizeof(sample), .conv_frame_size = 512},
+             counter::read, &src);
+  adc.configure({.sample_freq_hz = 24000, .speed = 0});
+
+  processed p;
+  uc::adc::acquisition<replay> acq(adc, {.buffer_samples = buffer_samples}, process, &p);
+  check("acquisition start", !acq.start() && acq.is_running() && adc.is_running());
+  check("acquisition start again fails", acq.start() == ESP_ERR_INVALID_STATE);
+
+  check("acquisition all buffers", wait_for([&] {
+    auto const st = acq.stats();
+    return st.buffers + st.dropped_buffers == buffers &&
+           st.buffers == p.calls.load(std::memory_order_acquire);
+  }));
+  auto const st = acq.stats();
+  std::printf("acquisition: %u buffers, %u dropped, %u pool overflows\n",
+              st.buffers, st.dropped_buffers, st.pool_overflows);
+  check("acquisition processed", st.buffers > 0);
+  check("acquisition contiguous", p.not_contiguous == 0 && p.unrouted == 0);
+  check("acquisition no overflow", st.pool_overflows == 0);
+
+  check("acquisition stop", !acq.stop() && !acq.is_running() && !adc.is_running());
+  check("acquisition stop again", !acq.stop());
+
+  // More than the pool holds, not read: overflows only seen by a handler
+  src = {.length = 2 * length};
+  check("acquisition backend restart", !adc.start() &&
+                                       wait_for([&] { return adc.finished(); }));
+  adc.stop();
+  check("acquisition unregistered", adc.pool_overflows() != 0 &&
+                                    acq.stats().pool_overflows == 0);
+}
+
+struct self_stop {
+  uc::adc::acquisition<replay>* acq = nullptr;
+  sys::error                    error;
+  std::atomic<bool>             called{false};
+};
+
+static void
+stop_from_callback(uc::adc::acquisition<replay>::span_type, void* arg) {
+  auto& s = *static_cast<self_stop*>(arg);
+  if (s.called.load(std::memory_order_acquire))
+    return;
+  s.error = s.acq->stop();
+  s.called.store(true, std::memory_order_release);
+}
+
+/**
+ * stop() from the processing callback would wait for its own task
+ */
+static void
+acquisition_self_stop() {
+  counter src{.length = length};
+  replay adc({.max_store_buf_size = length * sizeof(sample), .conv_frame_size = 512},
+             counter::read, &src);
+  adc.configure({.sample_freq_hz = 24000, .speed = 0});
+
+  self_stop s;
+  uc::adc::acquisition<replay> acq(adc, {.buffer_samples = buffer_samples},
+                                   stop_from_callback, &s);
+  s.acq = &acq;
+  check("acquisition self stop start", !acq.start());
+  check("acquisition self stop returns", wait_for([&] {
+    return s.called.load(std::memory_order_acquire);
+  }));
+  check("acquisition self stop fails", s.error == ESP_ERR_INVALID_STATE &&
+                                       acq.is_running());
+  check("acquisition stop after self stop", !acq.stop() && !acq.is_running());
+}
+
+static void
+frame_ring() {
+  constexpr const std::size_t frame_size = 512;
+  constexpr const std::size_t frame_samples = frame_size / sizeof(sample);
+  counter src{.length = 64 * frame_samples};
+  // The pool is never read: must hold all frames
+  replay adc({.max_store_buf_size = 64 * frame_size, .conv_frame_size = frame_size},
+             counter::read, &src);
+  adc.configure({.sample_freq_hz = 24000, .speed = 20});
+
+  static uc::adc::frame_ring<replay, 4, frame_size> ring;
+  check("frame ring attach", !ring.attach(adc));
+  check("frame ring start", !adc.start());
+
+  std::size_t frames = 0, records = 0, not_contiguous = 0;
+  while (true) {
+    auto const frame = ring.acquire(std::chrono::milliseconds(100));
+    if (frame.empty()) {
+      if (adc.finished() && ring.pending() == 0)
+        break;
+      continue;
+    }
+    ++frames;
+    records += frame.size();
+    for (std::size_t i = 1; i < frame.size(); ++i)
+      not_contiguous += frame[i].data * 2u + frame[i].number !=
+                        frame[0].data * 2u + frame[0].number + i;
+    ring.release();
+  }
+  adc.stop();
+
+  std::printf("frame ring: %zu frames, %u overruns\n", frames, ring.overruns());
+  check("frame ring frames", frames > 0 && frames + ring.overruns() == adc.frames());
+  check("frame ring records", records == frames * frame_samples);
+  check("frame ring contiguous", not_contiguous == 0);
+  check("frame ring not truncated", ring.truncated() == 0);
+}
+
+static void
+frame_ring_truncated() {
+  constexpr const std::size_t frame_size = 512;
+  counter src{.length = 8 * frame_size / sizeof(sample)};
+  // Backend frames twice the ring slot
+  replay adc({.max_store_buf_size = 8 * frame_size, .conv_frame_size = frame_size},
+             counter::read, &src);
+  adc.configure({.sample_freq_hz = 24000, .speed = 0});
+
+  static uc::adc::frame_ring<replay, 8, frame_size / 2> ring;
+  check("frame ring truncated attach", !ring.attach(adc));
+  check("frame ring truncated start", !adc.start() &&
+                                      wait_for([&] { return adc.finished(); }));
+  adc.stop();
+
+  std::size_t records = 0;
+  while (ring.pending() != 0) {
+    records += ring.acquire().size();
+    ring.release();
+  }
+  check("frame ring truncated count", ring.truncated() == adc.frames() &&
+                                      ring.overruns() == 0);
+  check("frame ring truncated size", records == adc.frames() * ring.frame_samples);
+}
+
+int main() {
+  acquisition();
+  acquisition_self_stop();
+  frame_ring();
+  frame_ring_truncated();
+
+  return harness::result();
+}
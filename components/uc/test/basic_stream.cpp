@@ -0,0 +1,130 @@
+/**
+ * @file basic_stream.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Compile time typed stream: pattern table, conversion mode, channel
+ *        checks and demux, over the host driver stub (ESP32S3 type 2)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <array>
+
+#include "uc/adc/basic_stream.hpp"
+
+#include "wave.hpp"
+#include "wave/channel.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+
+using voltage = uc::adc::channel<ADC_UNIT_1, ADC_CHANNEL_0>;
+using current = uc::adc::channel<ADC_UNIT_1, ADC_CHANNEL_3, ADC_ATTEN_DB_6, 11>;
+using other_unit = uc::adc::channel<ADC_UNIT_2, ADC_CHANNEL_0>;
+
+using single = uc::adc::basic_stream<uc::compiled_mcu, voltage, current>;
+using both = uc::adc::basic_stream<uc::compiled_mcu, voltage, other_unit>;
+using unit2 = uc::adc::basic_stream<uc::compiled_mcu, other_unit>;
+
+// Pattern table, conversion mode and format are constants
+static_assert(single::channels == 2);
+static_assert(single::format == uc::adc_stream_format::type2);
+static_assert(single::patterns[0].channel == ADC_CHANNEL_0 &&
+              single::patterns[0].unit == ADC_UNIT_1 &&
+              single::patterns[0].atten == ADC_ATTEN_DB_12 &&
+              single::patterns[0].bit_width == SOC_ADC_DIGI_MAX_BITWIDTH);
+static_assert(single::patterns[1].channel == ADC_CHANNEL_3 &&
+              single::patterns[1].atten == ADC_ATTEN_DB_6 &&
+              single::patterns[1].bit_width == 11);
+static_assert(single::single_unit &&
+              single::conv_mode == ADC_CONV_SINGLE_UNIT_1);
+static_assert(unit2::single_unit && unit2::conv_mode == ADC_CONV_SINGLE_UNIT_2);
+static_assert(!both::single_unit && both::conv_mode == ADC_CONV_BOTH_UNIT);
+static_assert(std::is_same_v<single::channel_type<1>, current>);
+
+template<typename Stream>
+static typename Stream::data
+make(std::uint32_t unit, std::uint32_t channel, std::uint32_t value) {
+  typename Stream::data d;
+  d.raw_data().type2.unit = unit;
+  d.raw_data().type2.channel = channel;
+  d.raw_data().type2.data = value;
+  return d;
+}
+
+static void
+channel_checks() {
+  auto const v = make<single>(ADC_UNIT_1, ADC_CHANNEL_0, 1);
+  auto const c = make<single>(ADC_UNIT_1, ADC_CHANNEL_3, 1);
+  check("is<I> single unit", single::is<0>(v) && !single::is<1>(v) &&
+                             single::is<1>(c) && !single::is<0>(c));
+
+  // Same channel number at both units: the unit tells them apart
+  auto const u1 = make<both>(ADC_UNIT_1, ADC_CHANNEL_0, 1);
+  auto const u2 = make<both>(ADC_UNIT_2, ADC_CHANNEL_0, 1);
+  check("is<I> both units", both::is<0>(u1) && !both::is<1>(u1) &&
+                            both::is<1>(u2) && !both::is<0>(u2));
+}
+
+static void
+stream() {
+  single adc({.max_store_buf_size = 1024, .conv_frame_size = 256, .flags = {}});
+  check("basic_stream initiated", adc.is_initiated());
+  check("basic_stream configure", !adc.configure(20000));
+
+  // The pattern table reaches the driver
+  auto const* driver = adc.native().native_handle();
+  check("basic_stream driver config",
+        driver->conv.pattern_num == 2 &&
+        driver->conv.sample_freq_hz == 20000 &&
+        driver->conv.conv_mode == ADC_CONV_SINGLE_UNIT_1 &&
+        driver->conv.format == ADC_DIGI_OUTPUT_FORMAT_TYPE2 &&
+        driver->conv.adc_pattern[0].channel == ADC_CHANNEL_0 &&
+        driver->conv.adc_pattern[1].channel == ADC_CHANNEL_3 &&
+        driver->conv.adc_pattern[1].bit_width == 11);
+
+  std::array<single::data, 32> frame;
+  for (std::uint32_t i = 0; i < frame.size(); ++i)
+    frame[i] = make<single>(ADC_UNIT_1,
+                            i % 2 ? ADC_CHANNEL_3 : ADC_CHANNEL_0, i);
+  check("basic_stream start", !adc.start());
+  adc_stub::convert(adc.native().native_handle(), frame.data(), sizeof(frame));
+
+  std::array<single::data, 32> data;
+  auto const r = adc.read(data.data(), data.size(), 0);
+  check("basic_stream read", r && r.readed == data.size());
+  check("basic_stream stop", !adc.stop());
+
+  // Demux in channel order
+  std::uint32_t v[16], c[16];
+  auto dmx = single::make_demux({v, c});
+  dmx(data.data(), r.readed);
+  bool ordered = dmx.size(0) == 16 && dmx.size(1) == 16 &&
+                 dmx.dropped().total() == 0;
+  for (std::size_t i = 0; ordered && i < 16; ++i)
+    ordered = dmx.channel(0)[i] == 2 * i && dmx.channel(1)[i] == 2 * i + 1;
+  check("basic_stream make_demux", ordered);
+
+  // wave::channel_range straight over the records
+  auto [begin, end] = wave::channel_range(data.begin(), data.begin() + r.readed,
+                                          ADC_CHANNEL_3);
+  std::size_t count = 0;
+  bool odd = true;
+  for (; begin != end; ++begin, ++count)
+    odd = odd && begin->value() == 2 * count + 1;
+  check("basic_stream channel_range", count == 16 && odd);
+  auto const [first, last] = wave::channel_range(data.begin(), data.end(),
+                                                 ADC_CHANNEL_0);
+  check("basic_stream channel_range mean", wave::mean(first, last), 15, 1e-12);
+}
+
+int main() {
+  channel_checks();
+  stream();
+
+  return harness::result();
+}
@@ -0,0 +1,91 @@
+/**
+ * @file demux.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Demux routing, drop counters and clear over driver records
+ *        (ESP32S3 type 2, see stub/hal/adc_types.h)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "uc/adc/data.hpp"
+#include "uc/adc/demux.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+using data = uc::adc::native_data;
+using demux = uc::adc::demux<2, data>;
+
+static data
+make(std::uint32_t channel, std::uint32_t value) {
+  data d;
+  d.raw_data().type2.channel = channel;
+  d.raw_data().type2.data = value;
+  d.raw_data().type2.unit = ADC_UNIT_1;
+  return d;
+}
+
+static void
+routing() {
+  std::uint32_t voltage[8], current[8];
+  demux dmx(ADC_UNIT_1, {ADC_CHANNEL_0, ADC_CHANNEL_3}, {voltage, current});
+
+  // Interleaved, plus an invalid (channel 12 of 10) and an unmapped record
+  std::vector<data> records{make(0, 100), make(3, 200), make(12, 1), make(0, 101),
+                            make(5, 2), make(3, 201), make(0, 102)};
+  check("demux stored", dmx(records.data(), records.size()) == 5);
+  auto const v = dmx.channel(0), c = dmx.channel(1);
+  check("demux channel 0", v.size() == 3 && v[0] == 100 && v[1] == 101 && v[2] == 102);
+  check("demux channel 1", c.size() == 2 && c[0] == 200 && c[1] == 201);
+  check("demux channel number", dmx.channel_number(0) == ADC_CHANNEL_0 &&
+                                dmx.channel_number(1) == ADC_CHANNEL_3);
+  check("demux invalid", dmx.dropped().invalid == 1);
+  check("demux unmapped", dmx.dropped().unmapped == 1);
+
+  // Keeps filling across calls, up to the buffer size
+  std::vector<data> more;
+  for (std::uint32_t i = 0; i < 8; ++i)
+    more.push_back(make(0, 103 + i));
+  check("demux next call", dmx(more.data(), more.size()) == 5);
+  check("demux full", dmx.full(0) && !dmx.full(1) && dmx.size(0) == 8 &&
+                      dmx.channel(0)[7] == 107);
+  check("demux overflow", dmx.dropped().overflow == 3 && dmx.dropped().total() == 5);
+
+  dmx.clear();
+  check("demux clear", dmx.size(0) == 0 && dmx.size(1) == 0 &&
+                       dmx.dropped().total() == 5);
+  dmx(records.data(), 2);
+  check("demux after clear", dmx.channel(0)[0] == 100 && dmx.channel(1)[0] == 200);
+  dmx.reset_drops();
+  check("demux reset drops", dmx.dropped().total() == 0);
+}
+
+static void
+mapping() {
+  // The last mapping of a channel wins; the other buffer never fills
+  std::uint32_t a[4], b[4];
+  uc::adc::demux<2, data> dmx(ADC_UNIT_1, {ADC_CHANNEL_2, ADC_CHANNEL_2}, {a, b});
+  auto const d = make(2, 7);
+  dmx(&d, 1);
+  check("demux repeated channel", dmx.size(0) == 0 && dmx.size(1) == 1);
+
+  // Channel numbers out of the 4 bit field are never routed
+  std::uint32_t c[4];
+  uc::adc::demux<1, data> out_of_range(ADC_UNIT_1, {16}, {c});
+  out_of_range(&d, 1);
+  check("demux channel out of range", out_of_range.size(0) == 0 &&
+                                      out_of_range.dropped().unmapped == 1);
+}
+
+int main() {
+  routing();
+  mapping();
+
+  return harness::result();
+}
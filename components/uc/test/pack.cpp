@@ -0,0 +1,119 @@
+/**
+ * @file pack.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Round trip and size of the ADC sample encodings
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "uc/adc/pack.hpp"
+#include "uc/adc/replay.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+
+static bool
+round_trip(uc::adc::encoding enc, const std::vector<std::uint16_t>& in,
+           std::size_t* packed_size = nullptr) {
+  std::vector<std::uint8_t> buffer(sizeof(uc::adc::packed_header) +
+                                   uc::adc::max_size(enc, in.size()));
+  std::size_t const size = uc::adc::pack(enc, 7, 3, in.begin(), in.end(), buffer);
+  if (packed_size)
+    *packed_size = size;
+  if (size == 0 && !in.empty())
+    return false;
+
+  uc::adc::packed_header header;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  if (header.sequence != 7 || header.channel != 3 ||
+      header.format != enc || header.count != in.size())
+    return false;
+
+  std::span<const std::uint8_t> payload(buffer.data() + sizeof(header),
+                                        size - sizeof(header));
+  std::vector<std::uint16_t> out;
+  std::size_t consumed = 0;
+  switch (enc) {
+    case uc::adc::encoding::raw16:
+      consumed = uc::adc::unpack_raw16(payload, header.count, std::back_inserter(out));
+      break;
+    case uc::adc::encoding::packed12:
+      consumed = uc::adc::unpack12(payload, header.count, std::back_inserter(out));
+      break;
+    case uc::adc::encoding::delta:
+      consumed = uc::adc::unpack_delta(payload, header.count, std::back_inserter(out));
+      break;
+  }
+  return consumed == payload.size() && out == in;
+}
+
+int main() {
+  harness::signal sig{.noise = 2};
+  auto const sine = sig.make<std::uint16_t>(1001);    // Odd count
+  std::vector<std::uint16_t> const edges{0, 4095, 0, 4095, 1, 4094, 2048};
+  std::vector<std::uint16_t> const wide{0, 65535, 0, 32768, 65535};
+
+  for (auto enc : {uc::adc::encoding::raw16,
+                   uc::adc::encoding::packed12,
+                   uc::adc::encoding::delta}) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "round trip %d sine", static_cast<int>(enc));
+    check(name, round_trip(enc, sine));
+    std::snprintf(name, sizeof(name), "round trip %d edges", static_cast<int>(enc));
+    check(name, round_trip(enc, edges));
+    std::snprintf(name, sizeof(name), "round trip %d empty", static_cast<int>(enc));
+    check(name, round_trip(enc, {}));
+  }
+  check("round trip delta 16 bits", round_trip(uc::adc::encoding::delta, wide));
+  check("round trip raw16 16 bits", round_trip(uc::adc::encoding::raw16, wide));
+
+  std::size_t packed = 0, delta = 0;
+  round_trip(uc::adc::encoding::packed12, sine, &packed);
+  round_trip(uc::adc::encoding::delta, sine, &delta);
+  check("packed12 size", packed == sizeof(uc::adc::packed_header) + 1502);
+  std::printf("1001 samples: records %zu bytes, packed12 %zu, delta %zu\n",
+              1001 * sizeof(std::uint32_t), packed, delta);
+
+  // Slow signal: deltas fit 1 byte
+  harness::signal slow{.frequency = 1};
+  std::size_t slow_delta = 0;
+  check("round trip delta slow", round_trip(uc::adc::encoding::delta,
+                                            slow.make<std::uint16_t>(1000),
+                                            &slow_delta));
+  check("delta slow size", slow_delta < sizeof(uc::adc::packed_header) + 1100);
+
+  // Records and short buffers
+  uc::adc::sample records[3]{{0, 0x123}, {0, 0x456}, {0, 0x789}};
+  std::uint8_t out[8];
+  check("pack12 records", uc::adc::pack12(records, records + 3, out) == 5 &&
+                          out[0] == 0x23 && out[1] == 0x61 && out[2] == 0x45 &&
+                          out[3] == 0x89 && out[4] == 0x07);
+  check("pack12 too small", uc::adc::pack12(records, records + 3,
+                                            std::span<std::uint8_t>(out, 4)) == 0);
+  check("pack too small", uc::adc::pack(uc::adc::encoding::raw16, 0, 0,
+                                        records, records + 3, out) == 0);
+  // Count must fit the header
+  std::vector<std::uint16_t> const many(UINT16_MAX + 1, 1);
+  std::vector<std::uint8_t> big(sizeof(uc::adc::packed_header) +
+                                uc::adc::max_size(uc::adc::encoding::raw16, many.size()));
+  check("pack too many samples", uc::adc::pack(uc::adc::encoding::raw16, 0, 0,
+                                               many.begin(), many.end(), big) == 0);
+  check("pack max samples", uc::adc::pack(uc::adc::encoding::raw16, 0, 0,
+                                          many.begin() + 1, many.end(), big) ==
+                            big.size() - 2);
+  std::uint16_t values[3];
+  check("unpack truncated", uc::adc::unpack_delta(std::span<const std::uint8_t>(out, 0),
+                                                  1, values) == 0 &&
+                            uc::adc::unpack12(std::span<const std::uint8_t>(out, 4),
+                                              3, values) == 0);
+
+  return harness::result();
+}
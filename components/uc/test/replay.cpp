@@ -0,0 +1,268 @@
+/**
+ * @file replay.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC pipeline on Linux: replay backend, consumer woken by
+ *        on_conv_done, wave processing and triggered capture
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * uc_replay [--soak <seconds>]
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "uc/adc/backend.hpp"
+#include "uc/adc/capture.hpp"
+#include "uc/adc/replay.hpp"
+
+#include "wave.hpp"
+#include "wave/channel.hpp"
+#include "wave/sensor.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+using replay = uc::adc::replay<>;
+using waveform = uc::adc::waveform<>;
+
+static constexpr const wave::linear unity{1, 0};
+using unity_sensor = wave::sensor<unity>;
+
+static constexpr const std::uint32_t sample_freq = 24000;
+
+/**
+ * Plays the role of the task notified at the conversion ISR
+ */
+struct consumer {
+  std::mutex              mtx;
+  std::condition_variable cv;
+  unsigned                notified = 0;
+  unsigned                overflows = 0;
+
+  static bool
+  conv_done(replay::handler, const replay::event_data*, void* arg) noexcept {
+    auto* self = static_cast<consumer*>(arg);
+    {
+      std::lock_guard lock(self->mtx);
+      ++self->notified;
+    }
+    self->cv.notify_one();
+    return false;
+  }
+
+  static bool
+  pool_ovf(replay::handler, const replay::event_data*, void* arg) noexcept {
+    ++static_cast<consumer*>(arg)->overflows;
+    return false;
+  }
+
+  /**
+   * Reads until the source finishes or 'limit' records were read
+   */
+  template<typename Func>
+  std::size_t run(replay& adc, Func&& func, std::size_t limit = 0) {
+    replay::data data[256];
+    std::size_t total = 0;
+    while (limit == 0 || total < limit) {
+      {
+        std::unique_lock lock(mtx);
+        cv.wait_for(lock, std::chrono::milliseconds(10), [this] { return notified != 0; });
+        notified = 0;
+      }
+      bool const finished = adc.finished();
+      while (auto result = adc.read(data, std::size(data), 0)) {
+        func(data, result.readed);
+        total += result.readed;
+      }
+      if (finished)
+        break;
+    }
+    return total;
+  }
+};
+
+static_assert(uc::adc::backend<replay>);
+
+static void
+synthetic_paced() {
+  constexpr const std::size_t length = sample_freq / 10;    // 100 ms
+  constexpr const double speed = 4;
+  waveform wf(sample_freq, {
+    {.number = 0, .offset = 2048, .amplitude = 1000, .frequency = 60},
+    {.number = 3, .offset = 2048, .amplitude = 500, .frequency = 60, .phase = 1}
+  }, length);
+
+  consumer cs;
+  replay adc({.max_store_buf_size = 4096, .conv_frame_size = 512},
+             waveform::read, &wf);
+  check("configure", !adc.configure({.sample_freq_hz = sample_freq, .speed = speed}));
+  check("register_handler", !adc.register_handler({
+    .on_conv_done = consumer::conv_done,
+    .on_pool_ovf = consumer::pool_ovf
+  }, &cs));
+
+  std::vector<replay::data> received;
+  uc::adc::capture<64, 192> scope({
+    .mode = uc::adc::trigger::type::rising,
+    .level = 2048,
+    .hysteresis = 50,
+    .auto_rearm = false
+  });
+  scope.arm();
+
+  auto const begin = std::chrono::steady_clock::now();
+  check("start", !adc.start());
+  check("start again fails", adc.start() == ESP_ERR_INVALID_STATE);
+  std::size_t const total = cs.run(adc, [&](const replay::data* data, std::size_t size) {
+    received.insert(received.end(), data, data + size);
+    scope.push(data, size, 0);
+  });
+  std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - begin;
+  adc.stop();
+
+  check("synthetic records", total == length);
+  check("synthetic frames", adc.frames() == (length + 127) / 128);
+  check("synthetic no overflow", adc.pool_overflows() == 0 && cs.overflows == 0);
+  // Only the lower bound: a loaded host may take any longer
+  check("synthetic paced", elapsed.count() >= 0.1 / speed);
+
+  auto [b0, e0] = wave::channel_range(received.begin(), received.end(), 0);
+  auto [b3, e3] = wave::channel_range(received.begin(), received.end(), 3);
+  check("channel 0 rms", wave::rms_sine_fused(b0, e0, 0, unity_sensor{}), 1000 / M_SQRT2, 1);
+  check("channel 3 rms", wave::rms_sine_fused(b3, e3, 0, unity_sensor{}), 500 / M_SQRT2, 1);
+
+  auto const* frame = scope.acquire();
+  check("capture triggered", frame != nullptr);
+  if (frame) {
+    check("capture before trigger", frame->samples[frame->trigger_index - 1] < 2048);
+    check("capture at trigger", frame->samples[frame->trigger_index] >= 2048);
+    scope.release();
+  }
+}
+
+static void
+file_replay() {
+  char const* path = "uc_replay.bin";
+  std::vector<replay::data> recorded(5000);
+  waveform wf(sample_freq, {
+    {.number = 0, .frequency = 50, .noise = 20},
+    {.number = 1, .frequency = 150}
+  });
+  waveform::read(recorded.data(), recorded.size(), &wf);
+  std::FILE* fp = std::fopen(path, "wb");
+  std::fwrite(recorded.data(), sizeof(replay::data), recorded.size(), fp);
+  std::fclose(fp);
+
+  uc::adc::file_source<> src(path);
+  check("file open", src.is_open());
+  consumer cs;
+  // Pool holds the whole file: no pacing, no overflow
+  replay adc({.max_store_buf_size = 8 * 5000, .conv_frame_size = 400},
+             uc::adc::file_source<>::read, &src);
+  adc.configure({.sample_freq_hz = sample_freq, .speed = 0});
+  adc.register_handler({.on_conv_done = consumer::conv_done}, &cs);
+
+  std::vector<replay::data> played;
+  adc.start();
+  cs.run(adc, [&](const replay::data* data, std::size_t size) {
+    played.insert(played.end(), data, data + size);
+  });
+  adc.stop();
+  std::remove(path);
+
+  check("file records", played.size() == recorded.size());
+  check("file content", played.size() == recorded.size() &&
+        std::memcmp(played.data(), recorded.data(),
+                    recorded.size() * sizeof(replay::data)) == 0);
+}
+
+static void
+pool_overflow() {
+  waveform wf(sample_freq, {{}}, 10 * 256);
+  consumer cs;
+  replay adc({.max_store_buf_size = 4 * 256 * 4, .conv_frame_size = 4 * 256},
+             waveform::read, &wf);
+  adc.configure({.sample_freq_hz = sample_freq, .speed = 0});
+  adc.register_handler({
+    .on_conv_done = consumer::conv_done,
+    .on_pool_ovf = consumer::pool_ovf
+  }, &cs);
+  adc.start();
+  while (!adc.finished()) {}
+  adc.stop();
+
+  // Nobody reads: 4 frames fit the pool, the other 6 are discarded
+  check("overflow frames", adc.frames() == 4);
+  check("overflow count", adc.pool_overflows() == 6 && cs.overflows == 6);
+  replay::data data[100];
+  std::size_t drained = 0;
+  while (auto result = adc.read(data, std::size(data), 0))
+    drained += result.readed;
+  check("overflow pool drained", drained == 4 * 256);
+  check("read timeout", adc.read(data, std::size(data), 1).error == ESP_ERR_TIMEOUT);
+}
+
+/**
+ * Unpaced endless source through the consumer and wave: throughput and
+ * loss of the pipeline
+ */
+static void
+soak(double seconds) {
+  waveform wf(sample_freq * 10, {
+    {.number = 0, .amplitude = 1000, .frequency = 60, .noise = 5},
+    {.number = 3, .amplitude = 500, .frequency = 60}
+  });
+  consumer cs;
+  replay adc({.max_store_buf_size = 64 * 1024, .conv_frame_size = 1024},
+             waveform::read, &wf);
+  adc.configure({.sample_freq_hz = sample_freq * 10, .speed = 0});
+  adc.register_handler({
+    .on_conv_done = consumer::conv_done,
+    .on_pool_ovf = consumer::pool_ovf
+  }, &cs);
+
+  double rms = 0;
+  std::size_t blocks = 0;
+  auto const begin = std::chrono::steady_clock::now();
+  auto const limit = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<double>(seconds));
+  adc.start();
+  std::size_t total = 0;
+  while (std::chrono::steady_clock::now() < limit) {
+    total += cs.run(adc, [&](const replay::data* data, std::size_t size) {
+      auto [b, e] = wave::channel_range(data, data + size, 0);
+      rms += wave::rms_sine_fused(b, e, 0, unity_sensor{});
+      ++blocks;
+    }, 1 << 16);
+  }
+  adc.stop();
+  std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - begin;
+
+  harness::keep(rms);
+  std::printf("soak: %.1f s, %zu records (%.2f M/s), %zu blocks, %u frames, "
+              "%u overflows\n",
+              elapsed.count(), total, total / elapsed.count() / 1e6, blocks,
+              adc.frames(), adc.pool_overflows());
+  check("soak records", total > 0);
+}
+
+int main(int argc, char** argv) {
+  double soak_time = 0.2;
+  if (argc > 2 && std::strcmp(argv[1], "--soak") == 0)
+    soak_time = std::atof(argv[2]);
+
+  synthetic_paced();
+  file_replay();
+  pool_overflow();
+  soak(soak_time);
+
+  return harness::result();
+}
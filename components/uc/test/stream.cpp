@@ -0,0 +1,161 @@
+/**
+ * @file stream.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC stream telemetry counters and move, over the host driver stub
+ *        (stub/esp_adc/adc_continuous.h)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include "uc/adc/stream.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+using data = uc::adc::stream::data;
+
+static constexpr const std::size_t frame_samples = 64;
+static constexpr const std::uint32_t frame_size = frame_samples * sizeof(data);
+static constexpr const uc::adc::stream::config cfg{
+  .max_store_buf_size = 4 * frame_size,
+  .conv_frame_size = frame_size,
+  .flags = {}
+};
+
+/**
+ * Frame of channel 'ch' records, 'invalid' of them with an invalid channel
+ */
+static std::array<data, frame_samples>
+make_frame(std::uint32_t ch, std::size_t invalid = 0) {
+  std::array<data, frame_samples> frame{};
+  for (std::size_t i = 0; i < frame.size(); ++i) {
+    frame[i].raw_data().type2.channel = i < invalid ? 15 : ch;
+    frame[i].raw_data().type2.data = static_cast<std::uint32_t>(i);
+  }
+  return frame;
+}
+
+struct user {
+  std::uint32_t conv_done = 0;
+  std::uint32_t pool_ovf = 0;
+
+  static bool
+  on_conv_done(uc::adc::stream::handler, const adc_continuous_evt_data_t*, void* arg) noexcept {
+    ++static_cast<user*>(arg)->conv_done;
+    return false;
+  }
+
+  static bool
+  on_pool_ovf(uc::adc::stream::handler, const adc_continuous_evt_data_t*, void* arg) noexcept {
+    ++static_cast<user*>(arg)->pool_ovf;
+    return false;
+  }
+};
+
+static void
+sleep_ms(unsigned ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void
+telemetry() {
+  uc::adc::stream adc(cfg);
+  check("stream initiated", adc.is_initiated());
+  user u;
+  check("stream register", !adc.register_handler({
+    .on_conv_done = user::on_conv_done,
+    .on_pool_ovf = user::on_pool_ovf
+  }, &u));
+  check("stream start", !adc.start());
+  check("stream register started fails",
+        adc.register_handler({}, nullptr) == ESP_ERR_INVALID_STATE);
+
+  auto const st0 = adc.stats();
+  check("stream stats empty", st0.frames == 0 && st0.bytes == 0 &&
+                              st0.min_interval == 0 && st0.max_interval == 0 &&
+                              st0.jitter() == 0);
+
+  auto const frame = make_frame(3, 5);
+  adc_stub::convert(adc.native_handle(), frame.data(), frame_size);
+  sleep_ms(2);
+  adc_stub::convert(adc.native_handle(), frame.data(), frame_size);
+  sleep_ms(10);
+  adc_stub::convert(adc.native_handle(), frame.data(), frame_size);
+  sleep_ms(2);
+
+  std::array<data, 3 * frame_samples> buffer;
+  auto const r = adc.read(buffer.data(), buffer.size(), 0);
+  check("stream read", r && r.readed == buffer.size());
+  check("stream validate", adc.validate(buffer.data(), r.readed, ADC_UNIT_1) == 15);
+
+  auto const st = adc.stats();
+  std::printf("stream: frames %u bytes %u interval %u-%u us latency %u us\n",
+              st.frames, st.bytes, st.min_interval, st.max_interval, st.max_latency);
+  check("stream frames", st.frames == 3 && st.bytes == 3 * frame_size);
+  check("stream user callback", u.conv_done == 3 && u.pool_ovf == 0);
+  check("stream interval", st.min_interval >= 2000 && st.max_interval >= 10000 &&
+                           st.jitter() == st.max_interval - st.min_interval);
+  check("stream latency", st.max_latency >= 12000);
+  check("stream validate invalid", st.validate_invalid == 15);
+
+  // Pool holds 4 frames: the 5th overflows
+  for (unsigned i = 0; i < 5; ++i)
+    adc_stub::convert(adc.native_handle(), frame.data(), frame_size);
+  check("stream pool overflow", adc.stats().pool_overflows == 1 &&
+                                adc.stats().frames == 7 && u.pool_ovf == 1);
+
+  adc.reset_stats();
+  auto const rs = adc.stats();
+  check("stream reset", rs.frames == 0 && rs.bytes == 0 && rs.pool_overflows == 0 &&
+                        rs.validate_invalid == 0 && rs.max_latency == 0 &&
+                        rs.min_interval == 0 && rs.max_interval == 0);
+  check("stream stop", !adc.stop());
+}
+
+static void
+move() {
+  uc::adc::stream adc(cfg);
+  user u;
+  adc.register_handler({.on_conv_done = user::on_conv_done, .on_pool_ovf = nullptr}, &u);
+  auto const frame = make_frame(0);
+  adc.start();
+  adc_stub::convert(adc.native_handle(), frame.data(), frame_size);
+  adc.stop();
+
+  uc::adc::stream moved(std::move(adc));
+  check("stream moved", moved.is_initiated() && !adc.is_initiated());
+  check("stream moved stats", moved.stats().frames == 1 &&
+                              moved.stats().bytes == frame_size);
+
+  // The ISR now updates 'moved'
+  moved.start();
+  adc_stub::convert(moved.native_handle(), frame.data(), frame_size);
+  check("stream moved callbacks", moved.stats().frames == 2 &&
+                                  adc.stats().frames == 1 && u.conv_done == 2);
+
+#ifdef NDEBUG
+  // Asserts at debug builds
+  uc::adc::stream started(std::move(moved));
+  check("stream moved started", started.is_initiated() &&
+                                !started.start() &&
+                                adc_stub::convert(started.native_handle(),
+                                                  frame.data(), frame_size) &&
+                                started.stats().frames == 3 &&
+                                moved.stats().frames == 2);
+#endif
+}
+
+int main() {
+  telemetry();
+  move();
+
+  return harness::result();
+}
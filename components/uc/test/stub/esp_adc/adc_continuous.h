@@ -0,0 +1,181 @@
+/**
+ * @file adc_continuous.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC continuous driver of the host build. Conversions are made by
+ *        the test, calling adc_stub::convert() as the DMA ISR would
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_ESP_ADC_ADC_CONTINUOUS_H_
+#define COMPONENTS_UC_TEST_STUB_ESP_ADC_ADC_CONTINUOUS_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "esp_err.h"
+#include "hal/adc_types.h"
+
+typedef struct adc_continuous_ctx_t* adc_continuous_handle_t;
+
+typedef struct {
+  uint32_t max_store_buf_size;
+  uint32_t conv_frame_size;
+  struct {
+    uint32_t flush_pool: 1;
+  } flags;
+} adc_continuous_handle_cfg_t;
+
+typedef struct {
+  uint32_t                    pattern_num;
+  adc_digi_pattern_config_t*  adc_pattern;
+  uint32_t                    sample_freq_hz;
+  adc_digi_convert_mode_t     conv_mode;
+  adc_digi_output_format_t    format;
+} adc_continuous_config_t;
+
+typedef struct {
+  uint8_t*  conv_frame_buffer;
+  uint32_t  size;
+} adc_continuous_evt_data_t;
+
+typedef bool (*adc_continuous_callback_t)(adc_continuous_handle_t handle,
+                                          const adc_continuous_evt_data_t* edata,
+                                          void* user_data);
+
+typedef struct {
+  adc_continuous_callback_t on_conv_done;
+  adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+
+/**
+ * Driver state. Only 'started' matters to the callbacks registration, as
+ * the IDF driver (registering is only allowed stopped).
+ */
+struct adc_continuous_ctx_t {
+  adc_continuous_handle_cfg_t cfg{};
+  adc_continuous_config_t     conv{};
+  adc_digi_pattern_config_t   pattern[24]{};
+  adc_continuous_evt_cbs_t    cbs{};
+  void*                       user_data = nullptr;
+  bool                        started = false;
+  std::mutex                  mtx;
+  std::deque<uint8_t>         pool;
+};
+
+inline esp_err_t
+adc_continuous_new_handle(const adc_continuous_handle_cfg_t* cfg,
+                          adc_continuous_handle_t* handle) {
+  if (!cfg || !handle || cfg->conv_frame_size > cfg->max_store_buf_size)
+    return ESP_ERR_INVALID_ARG;
+  *handle = new adc_continuous_ctx_t;
+  (*handle)->cfg = *cfg;
+  return ESP_OK;
+}
+
+inline esp_err_t
+adc_continuous_deinit(adc_continuous_handle_t handle) {
+  if (handle->started)
+    return ESP_ERR_INVALID_STATE;
+  delete handle;
+  return ESP_OK;
+}
+
+inline esp_err_t
+adc_continuous_config(adc_continuous_handle_t handle,
+                      const adc_continuous_config_t* cfg) {
+  if (handle->started)
+    return ESP_ERR_INVALID_STATE;
+  if (cfg->pattern_num == 0 || cfg->pattern_num > 24)
+    return ESP_ERR_INVALID_ARG;
+  handle->conv = *cfg;
+  std::copy_n(cfg->adc_pattern, cfg->pattern_num, handle->pattern);
+  handle->conv.adc_pattern = handle->pattern;
+  return ESP_OK;
+}
+
+inline esp_err_t
+adc_continuous_register_event_callbacks(adc_continuous_handle_t handle,
+                                        const adc_continuous_evt_cbs_t* cbs,
+                                        void* user_data) {
+  if (handle->started)
+    return ESP_ERR_INVALID_STATE;
+  handle->cbs = *cbs;
+  handle->user_data = user_data;
+  return ESP_OK;
+}
+
+inline esp_err_t
+adc_continuous_start(adc_continuous_handle_t handle) {
+  if (handle->started)
+    return ESP_ERR_INVALID_STATE;
+  handle->started = true;
+  return ESP_OK;
+}
+
+inline esp_err_t
+adc_continuous_stop(adc_continuous_handle_t handle) {
+  if (!handle->started)
+    return ESP_ERR_INVALID_STATE;
+  handle->started = false;
+  return ESP_OK;
+}
+
+/**
+ * Non blocking: the test converts before reading
+ */
+inline esp_err_t
+adc_continuous_read(adc_continuous_handle_t handle,
+                    uint8_t* buf,
+                    uint32_t length_max,
+                    uint32_t* out_length,
+                    uint32_t /* timeout_ms */) {
+  std::lock_guard<std::mutex> lock(handle->mtx);
+  if (handle->pool.empty())
+    return ESP_ERR_TIMEOUT;
+  auto const n = std::min<std::size_t>(length_max, handle->pool.size());
+  std::copy_n(handle->pool.begin(), n, buf);
+  handle->pool.erase(handle->pool.begin(), handle->pool.begin() + n);
+  *out_length = static_cast<uint32_t>(n);
+  return ESP_OK;
+}
+
+namespace adc_stub {
+
+/**
+ * One conversion frame of 'size' bytes, as the DMA ISR: stored at the pool
+ * and signaled, or signaled as pool overflow if it doesn't fit. Returns
+ * false if the driver is stopped.
+ */
+inline bool
+convert(adc_continuous_handle_t handle, const void* frame, uint32_t size) {
+  if (!handle->started)
+    return false;
+
+  bool stored;
+  {
+    std::lock_guard<std::mutex> lock(handle->mtx);
+    stored = handle->pool.size() + size <= handle->cfg.max_store_buf_size;
+    if (stored) {
+      auto const* bytes = static_cast<const uint8_t*>(frame);
+      handle->pool.insert(handle->pool.end(), bytes, bytes + size);
+    }
+  }
+  adc_continuous_evt_data_t ev{
+    const_cast<uint8_t*>(static_cast<const uint8_t*>(frame)), size
+  };
+  auto const cb = stored ? handle->cbs.on_conv_done : handle->cbs.on_pool_ovf;
+  if (cb)
+    cb(handle, &ev, handle->user_data);
+  return true;
+}
+
+}  // namespace adc_stub
+
+#endif  // COMPONENTS_UC_TEST_STUB_ESP_ADC_ADC_CONTINUOUS_H_
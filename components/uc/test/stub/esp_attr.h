@@ -0,0 +1,18 @@
+/**
+ * @file esp_attr.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Placement attributes, empty at the host build
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_ESP_ATTR_H_
+#define COMPONENTS_UC_TEST_STUB_ESP_ATTR_H_
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+#endif  // COMPONENTS_UC_TEST_STUB_ESP_ATTR_H_
@@ -0,0 +1,27 @@
+/**
+ * @file esp_timer.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief esp_timer_get_time for the host build of sys/time.hpp
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_ESP_TIMER_H_
+#define COMPONENTS_UC_TEST_STUB_ESP_TIMER_H_
+
+#include <stdint.h>
+#include <chrono>
+
+/**
+ * Microseconds since the first call
+ */
+inline int64_t
+esp_timer_get_time() {
+  using clock = std::chrono::steady_clock;
+  static auto const boot = clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - boot).count();
+}
+
+#endif  // COMPONENTS_UC_TEST_STUB_ESP_TIMER_H_
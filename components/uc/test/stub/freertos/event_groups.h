@@ -0,0 +1,27 @@
+/**
+ * @file event_groups.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Event group types for the host build of sys/task.hpp. Event groups
+ *        are not implemented
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_FREERTOS_EVENT_GROUPS_H_
+#define COMPONENTS_UC_TEST_STUB_FREERTOS_EVENT_GROUPS_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef uint32_t  EventBits_t;
+typedef void*     EventGroupHandle_t;
+typedef struct {
+  EventBits_t bits;
+} StaticEventGroup_t;
+
+EventBits_t
+xEventGroupWaitBits(EventGroupHandle_t, EventBits_t, BaseType_t, BaseType_t,
+                    TickType_t);
+
+#endif  // COMPONENTS_UC_TEST_STUB_FREERTOS_EVENT_GROUPS_H_
@@ -0,0 +1,16 @@
+/**
+ * @file portmacro.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Port definitions: all at freertos/FreeRTOS.h at the host build
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_FREERTOS_PORTMACRO_H_
+#define COMPONENTS_UC_TEST_STUB_FREERTOS_PORTMACRO_H_
+
+#include "freertos/FreeRTOS.h"
+
+#endif  // COMPONENTS_UC_TEST_STUB_FREERTOS_PORTMACRO_H_
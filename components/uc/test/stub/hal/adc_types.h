@@ -0,0 +1,73 @@
+/**
+ * @file adc_types.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC types of the host build, as the ESP32S3 (type 2 records)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_HAL_ADC_TYPES_H_
+#define COMPONENTS_UC_TEST_STUB_HAL_ADC_TYPES_H_
+
+#include <stdint.h>
+
+typedef enum {
+  ADC_UNIT_1,
+  ADC_UNIT_2,
+} adc_unit_t;
+
+typedef enum {
+  ADC_CHANNEL_0,
+  ADC_CHANNEL_1,
+  ADC_CHANNEL_2,
+  ADC_CHANNEL_3,
+  ADC_CHANNEL_4,
+  ADC_CHANNEL_5,
+  ADC_CHANNEL_6,
+  ADC_CHANNEL_7,
+  ADC_CHANNEL_8,
+  ADC_CHANNEL_9,
+} adc_channel_t;
+
+typedef enum {
+  ADC_ATTEN_DB_0,
+  ADC_ATTEN_DB_2_5,
+  ADC_ATTEN_DB_6,
+  ADC_ATTEN_DB_12,
+} adc_atten_t;
+
+typedef enum {
+  ADC_CONV_SINGLE_UNIT_1 = 1,
+  ADC_CONV_SINGLE_UNIT_2 = 2,
+  ADC_CONV_BOTH_UNIT     = 3,
+  ADC_CONV_ALTER_UNIT    = 7,
+} adc_digi_convert_mode_t;
+
+typedef enum {
+  ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+  ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+} adc_digi_output_format_t;
+
+typedef struct {
+  uint8_t atten;
+  uint8_t channel;
+  uint8_t unit;
+  uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct {
+  union {
+    struct {
+      uint32_t data:          12;
+      uint32_t reserved12:    1;
+      uint32_t channel:       4;
+      uint32_t unit:          1;
+      uint32_t reserved17_31: 14;
+    } type2;
+    uint32_t val;
+  };
+} adc_digi_output_data_t;
+
+#endif  // COMPONENTS_UC_TEST_STUB_HAL_ADC_TYPES_H_
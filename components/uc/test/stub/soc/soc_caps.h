@@ -0,0 +1,19 @@
+/**
+ * @file soc_caps.h
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ADC capabilities of the host build, as the ESP32S3
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_UC_TEST_STUB_SOC_SOC_CAPS_H_
+#define COMPONENTS_UC_TEST_STUB_SOC_SOC_CAPS_H_
+
+#define SOC_ADC_PERIPH_NUM              (2)
+#define SOC_ADC_CHANNEL_NUM(PERIPH_NUM) ((PERIPH_NUM) == 0 ? 10 : 10)
+#define SOC_ADC_PATT_LEN_MAX            (24)
+#define SOC_ADC_DIGI_MAX_BITWIDTH       (12)
+
+#endif  // COMPONENTS_UC_TEST_STUB_SOC_SOC_CAPS_H_
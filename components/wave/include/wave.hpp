@@ -19,6 +19,9 @@
 #include <type_traits>
 #include <algorithm>
 
+#include "wave/fixed_point.hpp"
+#include "wave/sensor.hpp"
+
 namespace wave {
 
 template< class T >
@@ -29,23 +32,28 @@ struct remove_cvref {
 template< class T >
 using remove_cvref_t = typename remove_cvref<T>::type;
 
+/**
+ * Default accessor: the sample itself, or obj.value() for records (as
+ * uc::adc::stream::data). Records that return the value by copy can be
+ * read, but not modified in place.
+ */
 struct access {
   template<typename T>
-  static constexpr auto&
+  static constexpr decltype(auto)
   get(const T& obj) noexcept {
-    if constexpr (std::is_class_v<T>)
+    if constexpr (std::is_class_v<T> && !is_fixed_v<T>)
       return obj.value();
     else
-      return obj;
+      return (obj);
   }
 
   template<typename T>
-  static constexpr auto&
+  static constexpr decltype(auto)
   get(T& obj) noexcept {
-    if constexpr (std::is_class_v<T>)
+    if constexpr (std::is_class_v<T> && !is_fixed_v<T>)
       return obj.value();
     else
-      return obj;
+      return (obj);
   }
 };
 
@@ -59,14 +67,15 @@ T normalize(T value, T mini, T maxi) noexcept {
 template<typename Iter, typename Accessor = access>
 auto mean(Iter begin, Iter end) noexcept {
   std::size_t size = 0;
-  using value_type = remove_cvref_t<decltype(*begin)>;
-  value_type sum = 0;
+  using value_type = remove_cvref_t<decltype(Accessor::get(*begin))>;
+  using policy = numeric<value_type>;
+  typename policy::accumulator_type sum{};
   while (begin != end) {
-    sum += Accessor::get(*begin);
+    sum = policy::add(sum, Accessor::get(*begin));
     ++size;
     ++begin;
   }
-  return sum / size;
+  return policy::average(sum, size);
 }
 
 template<typename Iter, typename T, typename Accessor = access>
@@ -80,10 +89,15 @@ template<typename Iter, typename Accessor = access>
 void filter_first_order(Iter begin, Iter end, double weight) noexcept {
   assert(weight >= 0 && weight <= 1 && "Weight must be 0 <= weight <= 1");
 
+  using value_type = remove_cvref_t<decltype(Accessor::get(*begin))>;
+  using policy = numeric<value_type>;
+  auto const w = policy::weight(weight);
+
   Iter before = begin++;
   while (begin != end) {
-    Accessor::get(*begin) = weight * Accessor::get(*before) + 
-                           (1 - weight) * Accessor::get(*begin);
+    Accessor::get(*begin) = policy::blend(Accessor::get(*before),
+                                          Accessor::get(*begin),
+                                          w);
     before = begin++;
   }
 }
@@ -91,41 +105,82 @@ void filter_first_order(Iter begin, Iter end, double weight) noexcept {
 template<typename Iter, typename Accessor = access>
 auto rms_sine_square(Iter begin, Iter end) noexcept {
   std::size_t size = 0;
-  using value_type = remove_cvref_t<decltype(*begin)>;
-  value_type sum = 0.0;
+  using value_type = remove_cvref_t<decltype(Accessor::get(*begin))>;
+  using policy = numeric<value_type>;
+  typename policy::accumulator_type sum{};
   while (begin != end) {
-    sum += Accessor::get(*begin) * Accessor::get(*begin);
+    sum = policy::add_square(sum, Accessor::get(*begin));
     ++size;
     ++begin;
   }
-  return sum / size;
+  return policy::average(sum, size);
 }
 
 template<typename Iter, typename Accessor = access>
 auto rms_sine(Iter begin, Iter end) noexcept {
-  return std::sqrt(rms_sine_square<Iter, Accessor>(begin, end));
+  using value_type = remove_cvref_t<decltype(rms_sine_square<Iter, Accessor>(begin, end))>;
+  return numeric<value_type>::sqrt(rms_sine_square<Iter, Accessor>(begin, end));
+}
+
+/**
+ * Converts ADC readings using a sensor calibration profile (see
+ * wave/sensor.hpp). The default is the current transformer front-end.
+ */
+template<typename IterIn, typename IterOut, typename Accessor = access, typename Sensor>
+void convert(IterIn begin, IterIn end, IterOut out, const Sensor& sensor) {
+  std::transform(begin, end, out, [&](auto v) {
+    return sensor(Accessor::get(v));
+  });
 }
 
 template<typename IterIn, typename IterOut, typename Accessor = access>
 void convert(IterIn begin, IterIn end, IterOut out) {
-    // Circuit polarization parameters for currente sensor
-    double Vmax = 2.450;							// Maximum voltage ADC can read [V];
-    double Vmin = 0.120;							// Minimum voltage ADC can read [V];                     
-    int d_max = 2895;                              // Max decimal value correlated with Vmax on 12 bit range;
-    // double GND  = 0.0;								// gnd for ADC converter [V];
-    double Vdc = 3.3;								// Voltage divisor supply [V];
-    double R1 = 180.0*1000;							// Voltage divisor top resistor [Ohms];
-    double R2 = 120.0*1000;							// Voltage divisor bottom resistor [Ohms];
-    double V_R2 = R2/(R1+R2)*Vdc;					// Voltage over R2 [V] or Vref for ADC converter [V];
-
-    // double Rb1 = 0.0;								// Burden resistor (bias) [Ohms];
-    double Rb2 = 120.0;								// Burden resistor (bias) [Ohms];
-    double N1 = 1;									// Current transformer sensor ration parameters
-    double N2 = 2000;								// Current transformer sensor ration parameters
-
-    std::transform(begin, end, out, [&](auto v) {
-        return (v * (Vmax - Vmin) / (d_max) + Vmin - V_R2) * (1 / Rb2) * (N2 / N1);
-    });
+  using out_type = remove_cvref_t<decltype(*out)>;
+  using value_type = std::conditional_t<std::is_arithmetic_v<out_type> ||
+                                          is_fixed_v<out_type>,
+                                        out_type, double>;
+  convert<IterIn, IterOut, Accessor>(begin, end, out,
+                                     default_sensor<value_type>{});
+}
+
+/**
+ * Single pass equivalent of:
+ * 
+ * filter_first_order(begin, end, weight);
+ * convert(begin, end, out, sensor);
+ * remove_constant(out, eout, mean(out, eout));
+ * rms_sine(out, eout);
+ * 
+ * The input range is not modified and no output buffer is needed. The filter
+ * state is kept at the input value type, so integer samples are truncated
+ * exactly as filter_first_order does in place. The DC component is removed
+ * using sums shifted by the first converted sample, avoiding the cancellation
+ * of the naive sum of squares.
+ */
+template<typename Iter,
+         typename Accessor = access,
+         typename Sensor = default_sensor<double>>
+double rms_sine_fused(Iter begin, Iter end, double weight,
+                      const Sensor& sensor = {}) noexcept {
+  assert(weight >= 0 && weight <= 1 && "Weight must be 0 <= weight <= 1");
+
+  if (begin == end)
+    return 0;
+
+  using value_type = remove_cvref_t<decltype(Accessor::get(*begin))>;
+  value_type filtered = Accessor::get(*begin);
+  double const shift = sensor(filtered);
+  double sum = 0, sum_square = 0;
+  std::size_t size = 1;
+  while (++begin != end) {
+    filtered = weight * filtered + (1 - weight) * Accessor::get(*begin);
+    double const value = sensor(filtered) - shift;
+    sum += value;
+    sum_square += value * value;
+    ++size;
+  }
+  double const mean = sum / size;
+  return std::sqrt(std::max(sum_square / size - mean * mean, 0.0));
 }
 
 }  // namespace wave
@@ -0,0 +1,269 @@
+/**
+ * @file accumulator.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Stateful mean/RMS accumulators that persist across ADC frames
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_WAVE_ACCUMULATOR_HPP_
+#define COMPONENTS_WAVE_ACCUMULATOR_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "wave.hpp"
+#include "wave/zero_crossing.hpp"
+
+namespace wave {
+
+/**
+ * Integration window of an accumulator.
+ *
+ * samples: a result is emitted every 'size' samples;
+ * cycles: a result is emitted every 'size' cycles, detected as rising
+ *         crossings (wave::zero_crossing) of the signal minus its mean, with
+ *         'hysteresis'. Samples before the first crossing are discarded at
+ *         it (they only estimate the mean), so every window starts at a
+ *         crossing. If 'size' cycles don't happen in 'max_samples' (0
+ *         disables), synced or not, the window is emitted anyway (e.g. a DC
+ *         or dead input). Such a window doesn't end at a crossing: the
+ *         samples up to the next one are discarded as at the start.
+ *
+ * A window with size 0 never emits; use result() directly.
+ */
+struct window {
+  enum class type {
+    samples,
+    cycles
+  };
+
+  type        mode = type::samples;
+  std::size_t size = 0;
+  double      hysteresis = 0;
+  std::size_t max_samples = 0;
+
+  [[nodiscard]] static constexpr window
+  samples(std::size_t n) noexcept {
+    return {type::samples, n, 0, 0};
+  }
+
+  [[nodiscard]] static constexpr window
+  cycles(std::size_t n,
+         double hysteresis = 0,
+         std::size_t max_samples = 0) noexcept {
+    return {type::cycles, n, hysteresis, max_samples};
+  }
+};
+
+template<typename T>
+struct mean_result {
+  T           mean;
+  std::size_t samples;
+};
+
+template<typename T>
+struct rms_result {
+  T           mean;
+  T           rms;      // RMS with the mean (DC) removed
+  std::size_t samples;
+};
+
+namespace detail {
+
+template<typename T>
+class mean_stats {
+ public:
+  using value_type = T;
+  using result_type = mean_result<T>;
+
+  constexpr void
+  push(T value) noexcept {
+    ++count_;
+    mean_ += (value - mean_) / count_;
+  }
+
+  [[nodiscard]] constexpr T
+  mean() const noexcept { return mean_; }
+
+  [[nodiscard]] constexpr std::size_t
+  count() const noexcept { return count_; }
+
+  [[nodiscard]] constexpr result_type
+  result() const noexcept { return {mean_, count_}; }
+
+  constexpr void
+  reset() noexcept {
+    mean_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  T           mean_ = 0;
+  std::size_t count_ = 0;
+};
+
+/**
+ * Welford online mean and variance
+ */
+template<typename T>
+class rms_stats {
+ public:
+  using value_type = T;
+  using result_type = rms_result<T>;
+
+  constexpr void
+  push(T value) noexcept {
+    ++count_;
+    T const delta = value - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (value - mean_);
+  }
+
+  [[nodiscard]] constexpr T
+  mean() const noexcept { return mean_; }
+
+  [[nodiscard]] constexpr std::size_t
+  count() const noexcept { return count_; }
+
+  [[nodiscard]] result_type
+  result() const noexcept {
+    return {mean_, count_ ? std::sqrt(m2_ / count_) : T{0}, count_};
+  }
+
+  constexpr void
+  reset() noexcept {
+    mean_ = 0;
+    m2_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  T           mean_ = 0;
+  T           m2_ = 0;
+  std::size_t count_ = 0;
+};
+
+}  // namespace detail
+
+template<typename Stats>
+class basic_accumulator {
+ public:
+  using value_type = typename Stats::value_type;
+  using result_type = typename Stats::result_type;
+
+  constexpr
+  basic_accumulator(window w = {}) noexcept
+   : window_(w),
+     detector_(1, static_cast<value_type>(w.hysteresis)) {}
+
+  template<typename Callback>
+  void push(value_type value, Callback&& callback) noexcept {
+    if (window_.mode == window::type::cycles && window_.size != 0) {
+      bool const rising = detector_.push(value - reference_.mean());
+      if (!calibrated_)
+        reference_.push(value);
+      bool const full = window_.max_samples != 0 &&
+                        stats_.count() == window_.max_samples;
+      if (!synced_) {
+        if (rising) {
+          synced_ = true;
+          stats_.reset();
+        } else if (full) {
+          emit(callback);
+        }
+      } else if ((rising && ++cycles_ == window_.size) || full) {
+        emit(callback);
+        // Closed by max_samples: aligned again at the next crossing
+        synced_ = rising;
+      }
+    }
+
+    stats_.push(value);
+
+    if (window_.mode == window::type::samples &&
+        stats_.count() == window_.size)
+      emit(callback);
+  }
+
+  void push(value_type value) noexcept {
+    push(value, [](const result_type&){});
+  }
+
+  template<typename Accessor = access,
+           typename Iter,
+           typename Callback>
+  void push(Iter begin, Iter end, Callback&& callback) noexcept {
+    while (begin != end) {
+      push(static_cast<value_type>(Accessor::get(*begin)), callback);
+      ++begin;
+    }
+  }
+
+  /**
+   * Result of the current (not emitted) window
+   */
+  [[nodiscard]] result_type
+  result() const noexcept {
+    return stats_.result();
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  count() const noexcept {
+    return stats_.count();
+  }
+
+  [[nodiscard]] constexpr const window&
+  get_window() const noexcept {
+    return window_;
+  }
+
+  void reset() noexcept {
+    stats_.reset();
+    reference_.reset();
+    detector_.reset();
+    cycles_ = 0;
+    synced_ = false;
+    calibrated_ = false;
+  }
+
+ private:
+  template<typename Callback>
+  void emit(Callback&& callback) noexcept {
+    callback(stats_.result());
+    reference_.reset();
+    reference_.push(stats_.mean());
+    calibrated_ = true;
+    stats_.reset();
+    cycles_ = 0;
+  }
+
+  window                          window_;
+  Stats                           stats_{};
+  // Mean used to detect crossings: running mean until the first window
+  // is emitted, then the mean of the last window
+  detail::mean_stats<value_type>  reference_{};
+  zero_crossing<value_type>       detector_;
+  std::size_t                     cycles_ = 0;
+  bool                            synced_ = false;
+  bool                            calibrated_ = false;
+};
+
+template<typename T = double>
+class mean_accumulator : public basic_accumulator<detail::mean_stats<T>> {
+ public:
+  using basic_accumulator<detail::mean_stats<T>>::basic_accumulator;
+};
+
+template<typename T = double>
+class rms_accumulator : public basic_accumulator<detail::rms_stats<T>> {
+ public:
+  using basic_accumulator<detail::rms_stats<T>>::basic_accumulator;
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_ACCUMULATOR_HPP_
@@ -0,0 +1,127 @@
+/**
+ * @file channel.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Accessor and iterator to read interleaved ADC records in place
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Any wave algorithm can run over the records returned by the ADC driver
+ * (as uc::adc::stream::data), without copying the samples to a value array:
+ *
+ * auto [b, e] = wave::channel_range(data, data + size, ADC_CHANNEL_0);
+ * double irms = wave::rms_sine_fused(b, e, 0.8);
+ */
+#ifndef COMPONENTS_WAVE_CHANNEL_HPP_
+#define COMPONENTS_WAVE_CHANNEL_HPP_
+
+#include <cstdint>
+#include <cstddef>
+
+#include <iterator>
+#include <utility>
+
+#include "wave.hpp"
+
+namespace wave {
+
+/**
+ * Accessor of interleaved multi channel records: channel() and value()
+ */
+struct channel_access {
+  template<typename T>
+  static constexpr auto
+  channel(const T& obj) noexcept {
+    return obj.channel();
+  }
+
+  template<typename T>
+  static constexpr decltype(auto)
+  get(const T& obj) noexcept {
+    return obj.value();
+  }
+};
+
+/**
+ * Forward iterator over the records of one channel. Records of other
+ * channels are skipped.
+ */
+template<typename Iter, typename Accessor = channel_access>
+class channel_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  using difference_type = typename std::iterator_traits<Iter>::difference_type;
+  using pointer = typename std::iterator_traits<Iter>::pointer;
+  using reference = typename std::iterator_traits<Iter>::reference;
+
+  constexpr channel_iterator() noexcept = default;
+
+  constexpr
+  channel_iterator(Iter it, Iter end, std::uint32_t channel) noexcept
+   : it_(it), end_(end), channel_(channel) {
+    skip();
+  }
+
+  constexpr reference
+  operator*() const noexcept {
+    return *it_;
+  }
+
+  constexpr pointer
+  operator->() const noexcept {
+    return &*it_;
+  }
+
+  constexpr channel_iterator&
+  operator++() noexcept {
+    ++it_;
+    skip();
+    return *this;
+  }
+
+  constexpr channel_iterator
+  operator++(int) noexcept {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  [[nodiscard]] constexpr Iter
+  base() const noexcept {
+    return it_;
+  }
+
+  friend constexpr bool
+  operator==(const channel_iterator& lhs, const channel_iterator& rhs) noexcept {
+    return lhs.it_ == rhs.it_;
+  }
+
+ private:
+  constexpr void
+  skip() noexcept {
+    while (it_ != end_ &&
+           static_cast<std::uint32_t>(Accessor::channel(*it_)) != channel_)
+      ++it_;
+  }
+
+  Iter          it_{};
+  Iter          end_{};
+  std::uint32_t channel_ = 0;
+};
+
+/**
+ * Begin/end pair of the records of 'channel' inside [begin, end)
+ */
+template<typename Accessor = channel_access, typename Iter>
+[[nodiscard]] constexpr auto
+channel_range(Iter begin, Iter end, std::uint32_t channel) noexcept {
+  using iterator = channel_iterator<Iter, Accessor>;
+  return std::pair<iterator, iterator>{iterator(begin, end, channel),
+                                       iterator(end, end, channel)};
+}
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_CHANNEL_HPP_
@@ -0,0 +1,161 @@
+/**
+ * @file decimator.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Low pass FIR filter and downsampling in a single pass
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * 26 kHz ADC stream to ~2 kHz, kept across reads:
+ *
+ * wave::decimator<13, 65, float> dec;
+ * auto [b, e] = wave::channel_range(data, data + size, channel);
+ * float* end = dec.process(b, e, out);
+ */
+#ifndef COMPONENTS_WAVE_DECIMATOR_HPP_
+#define COMPONENTS_WAVE_DECIMATOR_HPP_
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+
+#include <array>
+#include <numbers>
+#include <type_traits>
+
+#include "wave.hpp"
+
+namespace wave {
+
+/**
+ * Windowed sinc (Blackman) low pass with unitary DC gain. 'cutoff' is
+ * normalized to the sample frequency (0 < cutoff < 0.5).
+ */
+template<std::size_t Taps, typename T = float>
+[[nodiscard]] std::array<T, Taps>
+lowpass_taps(double cutoff) noexcept {
+  assert(cutoff > 0 && cutoff < 0.5 && "Cutoff must be 0 < cutoff < 0.5");
+
+  std::array<double, Taps> h;
+  double const middle = (Taps - 1) / 2.0;
+  double sum = 0;
+  for (std::size_t i = 0; i < Taps; ++i) {
+    double const n = i - middle;
+    double const sinc = n == 0
+                        ? 2 * cutoff
+                        : std::sin(2 * std::numbers::pi * cutoff * n) / (std::numbers::pi * n);
+    double const window = Taps == 1
+                          ? 1
+                          : 0.42
+                            - 0.5 * std::cos(2 * std::numbers::pi * i / (Taps - 1))
+                            + 0.08 * std::cos(4 * std::numbers::pi * i / (Taps - 1));
+    h[i] = sinc * window;
+    sum += h[i];
+  }
+
+  std::array<T, Taps> taps;
+  for (std::size_t i = 0; i < Taps; ++i)
+    taps[i] = static_cast<T>(h[i] / sum);
+  return taps;
+}
+
+/**
+ * FIR low pass followed by a downsample by Factor.
+ *
+ * Direct form FIR evaluated only at the kept outputs (every Factor-th
+ * input), the others are never computed: each output costs Taps
+ * multiply-adds, or Taps / Factor per input sample, the cost of a polyphase
+ * decomposition without splitting the taps. The delay line is a ring
+ * stored twice, as wave::fir, so the convolution reads a contiguous
+ * window. The state (delay line and phase) is kept across calls, so
+ * consecutive ADC frames are filtered as one stream.
+ */
+template<std::size_t Factor, std::size_t Taps, typename T = float>
+class decimator {
+ public:
+  using value_type = T;
+  using taps_type = std::array<T, Taps>;
+  static constexpr const std::size_t factor = Factor;
+  static constexpr const std::size_t taps = Taps;
+
+  static_assert(Factor > 0, "Factor must be greater than 0");
+  static_assert(Taps > 0, "At least one tap must be defined");
+  static_assert(std::is_floating_point_v<T>, "Must be a floating point type");
+
+  /**
+   * Default cutoff is 80% of the output Nyquist frequency
+   */
+  decimator(double cutoff = 0.4 / Factor) noexcept
+   : taps_(lowpass_taps<Taps, T>(cutoff)) {}
+
+  decimator(const taps_type& coefficients) noexcept
+   : taps_(coefficients) {}
+
+  /**
+   * Pushes one sample. Returns true when an output was written to 'y'.
+   */
+  bool push(value_type x, value_type& y) noexcept {
+    index_ = index_ == 0 ? Taps - 1 : index_ - 1;
+    delay_[index_] = x;
+    delay_[index_ + Taps] = x;
+    if (++phase_ != Factor)
+      return false;
+
+    phase_ = 0;
+    y = convolve(&delay_[index_]);
+    return true;
+  }
+
+  /**
+   * Writes one output every Factor inputs. Returns the end of the output.
+   */
+  template<typename Accessor = access, typename Iter, typename IterOut>
+  IterOut process(Iter begin, Iter end, IterOut out) noexcept {
+    value_type y;
+    while (begin != end) {
+      if (push(static_cast<value_type>(Accessor::get(*begin)), y)) {
+        *out = y;
+        ++out;
+      }
+      ++begin;
+    }
+    return out;
+  }
+
+  /**
+   * Maximum number of outputs of 'inputs' samples
+   */
+  [[nodiscard]] static constexpr std::size_t
+  output_size(std::size_t inputs) noexcept {
+    return (inputs + Factor - 1) / Factor;
+  }
+
+  [[nodiscard]] const taps_type&
+  coefficients() const noexcept {
+    return taps_;
+  }
+
+  void reset() noexcept {
+    delay_ = {};
+    index_ = 0;
+    phase_ = 0;
+  }
+
+ private:
+  value_type convolve(const value_type* x) const noexcept {
+    value_type acc = 0;
+    for (std::size_t i = 0; i < Taps; ++i)
+      acc += taps_[i] * x[i];
+    return acc;
+  }
+
+  taps_type                         taps_;
+  std::array<value_type, 2 * Taps>  delay_{};
+  std::size_t                       index_ = 0;
+  std::size_t                       phase_ = 0;
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_DECIMATOR_HPP_
@@ -0,0 +1,258 @@
+/**
+ * @file filter.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Stateful IIR/FIR filters that keep continuity across ADC frames
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Coefficients are compile time references, so the stage/tap loops are
+ * unrolled and the coefficients folded into the code:
+ *
+ * static constexpr std::array<wave::biquad_coefficients<float>, 2> lp{{
+ *  {b0, b1, b2, a1, a2},
+ *  {b0, b1, b2, a1, a2}
+ * }};
+ * wave::biquad_cascade<lp, float> filter;
+ * filter.process(begin, end, out);
+ */
+#ifndef COMPONENTS_WAVE_FILTER_HPP_
+#define COMPONENTS_WAVE_FILTER_HPP_
+
+#include <cstddef>
+
+#include <array>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+#include "wave.hpp"
+
+namespace wave {
+namespace detail {
+
+/**
+ * Calls 'func' for each input, writing to 'out'. Both are accessed through
+ * 'Accessor', so records can be filtered in place. Each output needs the
+ * state left by the previous one, so unrolling samples gives no parallelism;
+ * the unrolled loops are the biquad stages and FIR taps.
+ */
+template<typename Accessor,
+         typename Iter,
+         typename IterOut,
+         typename Func>
+IterOut
+for_each_sample(Iter begin, Iter end, IterOut out, Func&& func) noexcept {
+  while (begin != end) {
+    Accessor::get(*out) = func(Accessor::get(*begin));
+    ++out;
+    ++begin;
+  }
+  return out;
+}
+
+}  // namespace detail
+
+/**
+ * Stateful version of filter_first_order:
+ * y[n] = weight * y[n - 1] + (1 - weight) * x[n]
+ *
+ * The first sample ever pushed initializes the state.
+ */
+template<typename T = double>
+class first_order {
+ public:
+  using value_type = T;
+  using policy = numeric<T>;
+
+  first_order(double weight) noexcept
+   : weight_(policy::weight(weight)) {
+    assert(weight >= 0 && weight <= 1 && "Weight must be 0 <= weight <= 1");
+  }
+
+  value_type operator()(value_type x) noexcept {
+    if (!init_) {
+      init_ = true;
+      state_ = x;
+    } else
+      state_ = policy::blend(state_, x, weight_);
+    return state_;
+  }
+
+  template<typename Accessor = access, typename Iter, typename IterOut>
+  IterOut process(Iter begin, Iter end, IterOut out) noexcept {
+    return detail::for_each_sample<Accessor>(begin, end, out, *this);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void process(Iter begin, Iter end) noexcept {
+    process<Accessor>(begin, end, begin);
+  }
+
+  void reset() noexcept {
+    init_ = false;
+    state_ = value_type{};
+  }
+
+ private:
+  typename policy::weight_type  weight_;
+  value_type                    state_{};
+  bool                          init_ = false;
+};
+
+/**
+ * Normalized (a0 = 1) second order section:
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+template<typename T = double>
+struct biquad_coefficients {
+  T b0, b1, b2;
+  T a1, a2;
+};
+
+/**
+ * Cascade of biquads in direct form II transposed.
+ */
+template<const auto& Coefficients, typename T = double>
+class biquad_cascade {
+ public:
+  using value_type = T;
+  static constexpr const std::size_t stages = std::size(Coefficients);
+
+  static_assert(stages > 0, "At least one stage must be defined");
+  static_assert(std::is_floating_point_v<T>, "Must be a floating point type");
+
+  value_type operator()(value_type x) noexcept {
+    return run(x, std::make_index_sequence<stages>{});
+  }
+
+  template<typename Accessor = access, typename Iter, typename IterOut>
+  IterOut process(Iter begin, Iter end, IterOut out) noexcept {
+    return detail::for_each_sample<Accessor>(begin, end, out, *this);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void process(Iter begin, Iter end) noexcept {
+    process<Accessor>(begin, end, begin);
+  }
+
+  void reset() noexcept {
+    state_ = {};
+  }
+
+ private:
+  template<std::size_t I>
+  value_type stage(value_type x) noexcept {
+    constexpr auto const& c = Coefficients[I];
+    auto& s = state_[I];
+    value_type const y = static_cast<T>(c.b0) * x + s[0];
+    s[0] = static_cast<T>(c.b1) * x - static_cast<T>(c.a1) * y + s[1];
+    s[1] = static_cast<T>(c.b2) * x - static_cast<T>(c.a2) * y;
+    return y;
+  }
+
+  template<std::size_t ...I>
+  value_type run(value_type x, std::index_sequence<I...>) noexcept {
+    ((x = stage<I>(x)), ...);
+    return x;
+  }
+
+  std::array<std::array<value_type, 2>, stages> state_{};
+};
+
+/**
+ * FIR filter. The delay line is a ring buffer stored twice, so the
+ * convolution always reads a contiguous window without wrapping.
+ */
+template<const auto& Taps, typename T = double>
+class fir {
+ public:
+  using value_type = T;
+  static constexpr const std::size_t taps = std::size(Taps);
+
+  static_assert(taps > 0, "At least one tap must be defined");
+
+  value_type operator()(value_type x) noexcept {
+    index_ = index_ == 0 ? taps - 1 : index_ - 1;
+    delay_[index_] = x;
+    delay_[index_ + taps] = x;
+    return convolve(&delay_[index_], std::make_index_sequence<taps>{});
+  }
+
+  template<typename Accessor = access, typename Iter, typename IterOut>
+  IterOut process(Iter begin, Iter end, IterOut out) noexcept {
+    return detail::for_each_sample<Accessor>(begin, end, out, *this);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void process(Iter begin, Iter end) noexcept {
+    process<Accessor>(begin, end, begin);
+  }
+
+  void reset() noexcept {
+    delay_ = {};
+    index_ = 0;
+  }
+
+ private:
+  template<std::size_t ...I>
+  static value_type
+  convolve(const value_type* x, std::index_sequence<I...>) noexcept {
+    return ((static_cast<T>(Taps[I]) * x[I]) + ...);
+  }
+
+  std::array<value_type, 2 * taps>  delay_{};
+  std::size_t                       index_ = 0;
+};
+
+/**
+ * DC blocker: y[n] = x[n] - x[n-1] + pole * y[n-1]
+ *
+ * The first sample ever pushed initializes x[n-1], avoiding the step
+ * transient of the ADC offset.
+ */
+template<typename T = double>
+class dc_blocker {
+ public:
+  using value_type = T;
+
+  constexpr
+  dc_blocker(T pole = T(0.995)) noexcept
+   : pole_(pole) {}
+
+  value_type operator()(value_type x) noexcept {
+    if (!init_) {
+      init_ = true;
+      x_ = x;
+    }
+    y_ = x - x_ + pole_ * y_;
+    x_ = x;
+    return y_;
+  }
+
+  template<typename Accessor = access, typename Iter, typename IterOut>
+  IterOut process(Iter begin, Iter end, IterOut out) noexcept {
+    return detail::for_each_sample<Accessor>(begin, end, out, *this);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void process(Iter begin, Iter end) noexcept {
+    process<Accessor>(begin, end, begin);
+  }
+
+  void reset() noexcept {
+    x_ = y_ = value_type{};
+    init_ = false;
+  }
+
+ private:
+  value_type  pole_;
+  value_type  x_{};
+  value_type  y_{};
+  bool        init_ = false;
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_FILTER_HPP_
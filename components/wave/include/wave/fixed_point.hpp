@@ -0,0 +1,369 @@
+/**
+ * @file fixed_point.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Fixed point (Qm.n) type and numeric policies used by wave algorithms
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Precision contract (F = fractional bits):
+ * - every operation saturates at the type limits, it never wraps;
+ * - +, - are exact (before saturation);
+ * - *, mean, the sum of squares, sqrt and the filter blend are rounded to
+ *   nearest, error <= 0.5 LSB (2^-F) per operation;
+ * - from_double rounds to nearest, error <= 0.5 LSB;
+ * - convert gains are stored with 31 significant bits, relative error
+ *   <= 2^-31, plus the 0.5 LSB output rounding.
+ */
+#ifndef COMPONENTS_WAVE_FIXED_POINT_HPP_
+#define COMPONENTS_WAVE_FIXED_POINT_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <limits>
+#include <utility>
+#include <compare>
+#include <type_traits>
+
+namespace wave {
+namespace detail {
+
+template<typename Int>
+struct wider;
+
+template<> struct wider<std::int8_t>  { using type = std::int16_t; };
+template<> struct wider<std::int16_t> { using type = std::int32_t; };
+template<> struct wider<std::int32_t> { using type = std::int64_t; };
+
+template<typename Int>
+using wider_t = typename wider<Int>::type;
+
+template<typename Int, typename T>
+[[nodiscard]] constexpr Int
+saturate(T value) noexcept {
+  if (std::cmp_greater(value, std::numeric_limits<Int>::max()))
+    return std::numeric_limits<Int>::max();
+  if (std::cmp_less(value, std::numeric_limits<Int>::min()))
+    return std::numeric_limits<Int>::min();
+  return static_cast<Int>(value);
+}
+
+/**
+ * Arithmetic right shift rounding to nearest (half up)
+ */
+template<typename T>
+[[nodiscard]] constexpr T
+round_shift(T value, int shift) noexcept {
+  if (shift <= 0)
+    return value;
+  return (value + (T(1) << (shift - 1))) >> shift;
+}
+
+template<typename T>
+[[nodiscard]] constexpr T
+round_divide(T value, T divisor) noexcept {
+  return value >= 0 ? (value + divisor / 2) / divisor
+                    : (value - divisor / 2) / divisor;
+}
+
+[[nodiscard]] constexpr std::uint64_t
+isqrt(std::uint64_t value) noexcept {
+  std::uint64_t result = 0;
+  std::uint64_t bit = std::uint64_t(1) << 62;
+  while (bit > value)
+    bit >>= 2;
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else
+      result >>= 1;
+    bit >>= 2;
+  }
+  // Round to nearest
+  return value > result ? result + 1 : result;
+}
+
+[[nodiscard]] constexpr double
+pow2(int exp) noexcept {
+  double v = 1;
+  for (; exp > 0; --exp) v *= 2;
+  for (; exp < 0; ++exp) v /= 2;
+  return v;
+}
+
+/**
+ * Real number represented as mantissa * 2^-shift, with |mantissa| in
+ * [2^30, 2^31). Used to multiply integers by a constant gain without
+ * floating point.
+ */
+struct multiplier {
+  std::int32_t  mantissa = 0;
+  int           shift = 0;
+
+  [[nodiscard]] static constexpr multiplier
+  make(double value) noexcept {
+    if (value == 0)
+      return {};
+    double const abs = value < 0 ? -value : value;
+    double norm = abs;
+    int shift = 31;
+    while (norm >= 1) { norm /= 2; --shift; }
+    while (norm < 0.5) { norm *= 2; ++shift; }
+    auto mantissa = static_cast<std::int64_t>(norm * pow2(31) + 0.5);
+    if (mantissa == (std::int64_t(1) << 31)) {
+      mantissa >>= 1;
+      --shift;
+    }
+    return {static_cast<std::int32_t>(value < 0 ? -mantissa : mantissa), shift};
+  }
+
+  /**
+   * Returns value * this, with frac_bits fractional bits.
+   * |value| must be < 2^31.
+   */
+  [[nodiscard]] constexpr std::int64_t
+  apply(std::int64_t value, int frac_bits) const noexcept {
+    std::int64_t const product = static_cast<std::int64_t>(mantissa) * value;
+    int const sh = shift - frac_bits;
+    return sh >= 0 ? round_shift(product, sh) : product * (std::int64_t(1) << -sh);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Signed fixed point number with Frac fractional bits stored at Int.
+ */
+template<typename Int, int Frac>
+class fixed {
+ public:
+  static_assert(std::is_integral_v<Int> && std::is_signed_v<Int>,
+                "Storage must be a signed integer");
+  static_assert(Frac >= 0 && Frac < static_cast<int>(sizeof(Int) * 8),
+                "Fractional bits must fit storage");
+
+  using storage_type = Int;
+  using wider_type = detail::wider_t<Int>;
+  static constexpr const int fractional_bits = Frac;
+
+  constexpr fixed() noexcept = default;
+
+  [[nodiscard]] static constexpr fixed
+  from_raw(Int raw) noexcept {
+    fixed f;
+    f.raw_ = raw;
+    return f;
+  }
+
+  [[nodiscard]] static constexpr fixed
+  from_double(double value) noexcept {
+    double scaled = value * scale;
+    scaled += scaled < 0 ? -0.5 : 0.5;
+    if (scaled >= static_cast<double>(std::numeric_limits<Int>::max()))
+      return max();
+    if (scaled <= static_cast<double>(std::numeric_limits<Int>::min()))
+      return lowest();
+    return from_raw(static_cast<Int>(scaled));
+  }
+
+  [[nodiscard]] static constexpr fixed
+  max() noexcept {
+    return from_raw(std::numeric_limits<Int>::max());
+  }
+
+  [[nodiscard]] static constexpr fixed
+  lowest() noexcept {
+    return from_raw(std::numeric_limits<Int>::min());
+  }
+
+  [[nodiscard]] static constexpr fixed
+  epsilon() noexcept {
+    return from_raw(1);
+  }
+
+  [[nodiscard]] constexpr Int
+  raw() const noexcept {
+    return raw_;
+  }
+
+  [[nodiscard]] constexpr double
+  to_double() const noexcept {
+    return raw_ / scale;
+  }
+
+  constexpr fixed
+  operator-() const noexcept {
+    return from_raw(detail::saturate<Int>(-static_cast<wider_type>(raw_)));
+  }
+
+  constexpr fixed&
+  operator+=(fixed other) noexcept {
+    raw_ = detail::saturate<Int>(static_cast<wider_type>(raw_) + other.raw_);
+    return *this;
+  }
+
+  constexpr fixed&
+  operator-=(fixed other) noexcept {
+    raw_ = detail::saturate<Int>(static_cast<wider_type>(raw_) - other.raw_);
+    return *this;
+  }
+
+  constexpr fixed&
+  operator*=(fixed other) noexcept {
+    raw_ = detail::saturate<Int>(
+              detail::round_shift(static_cast<wider_type>(raw_) * other.raw_,
+                                  Frac));
+    return *this;
+  }
+
+  friend constexpr fixed
+  operator+(fixed lhs, fixed rhs) noexcept { return lhs += rhs; }
+  friend constexpr fixed
+  operator-(fixed lhs, fixed rhs) noexcept { return lhs -= rhs; }
+  friend constexpr fixed
+  operator*(fixed lhs, fixed rhs) noexcept { return lhs *= rhs; }
+
+  friend constexpr bool
+  operator==(fixed, fixed) noexcept = default;
+  friend constexpr auto
+  operator<=>(fixed, fixed) noexcept = default;
+
+ private:
+  static constexpr const double scale = detail::pow2(Frac);
+
+  Int raw_ = 0;
+};
+
+using q7 = fixed<std::int8_t, 7>;
+using q15 = fixed<std::int16_t, 15>;
+using q31 = fixed<std::int32_t, 31>;
+
+template<typename T>
+struct is_fixed : std::false_type {};
+
+template<typename Int, int Frac>
+struct is_fixed<fixed<Int, Frac>> : std::true_type {};
+
+template<typename T>
+static constexpr bool is_fixed_v = is_fixed<T>::value;
+
+/**
+ * Numeric policy used by the wave algorithms. The default keeps the
+ * plain arithmetic behaviour of the value type.
+ */
+template<typename T>
+struct numeric {
+  using value_type = T;
+  using accumulator_type = T;
+  using weight_type = double;
+
+  [[nodiscard]] static constexpr accumulator_type
+  add(accumulator_type acc, value_type value) noexcept {
+    return acc + value;
+  }
+
+  [[nodiscard]] static constexpr accumulator_type
+  add_square(accumulator_type acc, value_type value) noexcept {
+    return acc + value * value;
+  }
+
+  [[nodiscard]] static constexpr auto
+  average(accumulator_type acc, std::size_t size) noexcept {
+    return acc / size;
+  }
+
+  [[nodiscard]] static constexpr weight_type
+  weight(double w) noexcept {
+    return w;
+  }
+
+  [[nodiscard]] static constexpr value_type
+  blend(value_type before, value_type current, weight_type w) noexcept {
+    return w * before + (1 - w) * current;
+  }
+
+  [[nodiscard]] static auto
+  sqrt(value_type value) noexcept {
+    return std::sqrt(value);
+  }
+
+  [[nodiscard]] static constexpr value_type
+  from_double(double value) noexcept {
+    return static_cast<value_type>(value);
+  }
+};
+
+template<typename Int, int Frac>
+struct numeric<fixed<Int, Frac>> {
+  using value_type = fixed<Int, Frac>;
+  using accumulator_type = std::int64_t;
+  using weight_type = detail::wider_t<Int>;
+
+  [[nodiscard]] static constexpr accumulator_type
+  add(accumulator_type acc, value_type value) noexcept {
+    return acc + value.raw();
+  }
+
+  [[nodiscard]] static constexpr accumulator_type
+  add_square(accumulator_type acc, value_type value) noexcept {
+    return acc + detail::round_shift(
+                    static_cast<std::int64_t>(value.raw()) * value.raw(), Frac);
+  }
+
+  [[nodiscard]] static constexpr value_type
+  average(accumulator_type acc, std::size_t size) noexcept {
+    return value_type::from_raw(
+              detail::saturate<Int>(
+                detail::round_divide(acc, static_cast<std::int64_t>(size))));
+  }
+
+  /**
+   * Weight with Frac fractional bits at the wider type, so 1.0 is
+   * representable.
+   */
+  [[nodiscard]] static constexpr weight_type
+  weight(double w) noexcept {
+    return static_cast<weight_type>(w * detail::pow2(Frac) + 0.5);
+  }
+
+  [[nodiscard]] static constexpr value_type
+  blend(value_type before, value_type current, weight_type w) noexcept {
+    constexpr std::int64_t one = std::int64_t(1) << Frac;
+    std::int64_t const v = w * static_cast<std::int64_t>(before.raw()) +
+                           (one - w) * static_cast<std::int64_t>(current.raw());
+    return value_type::from_raw(
+              detail::saturate<Int>(detail::round_shift(v, Frac)));
+  }
+
+  [[nodiscard]] static constexpr value_type
+  sqrt(value_type value) noexcept {
+    if (value.raw() <= 0)
+      return value_type{};
+    return value_type::from_raw(
+              detail::saturate<Int>(
+                detail::isqrt(static_cast<std::uint64_t>(value.raw()) << Frac)));
+  }
+
+  [[nodiscard]] static constexpr value_type
+  from_double(double value) noexcept {
+    return value_type::from_double(value);
+  }
+
+  /**
+   * Returns offset + gain * sample, without floating point at run time.
+   */
+  [[nodiscard]] static constexpr value_type
+  affine(detail::multiplier gain, value_type offset,
+         std::int64_t sample) noexcept {
+    return value_type::from_raw(
+              detail::saturate<Int>(gain.apply(sample, Frac) + offset.raw()));
+  }
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_FIXED_POINT_HPP_
@@ -0,0 +1,274 @@
+/**
+ * @file power.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Active/apparent power, power factor and energy from interleaved
+ *        voltage/current samples
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_WAVE_POWER_HPP_
+#define COMPONENTS_WAVE_POWER_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+
+#include "wave.hpp"
+#include "wave/sensor.hpp"
+#include "wave/channel.hpp"
+#include "wave/zero_crossing.hpp"
+
+namespace wave {
+
+template<typename T = double>
+struct power_result {
+  T           voltage_rms = 0;
+  T           current_rms = 0;
+  T           active = 0;           // Real power [W]
+  T           apparent = 0;         // [VA]
+  T           reactive = 0;         // sqrt(S^2 - P^2) [var]
+  T           power_factor = 0;
+  double      frequency = 0;        // Only on cycle windows [Hz]
+  std::size_t samples = 0;
+};
+
+/**
+ * Streaming power meter.
+ *
+ * Voltage and current are sampled sequentially by the ADC pattern, so each
+ * current sample lags the previous voltage sample by 'skew' of the per
+ * channel sample period. The voltage is linearly interpolated at the
+ * current sample instant before multiplying. Use skew() to compute it from
+ * the pattern positions; any sensor phase shift (in samples) can be added
+ * to it.
+ *
+ * DC components are removed from both channels (sums are shifted by the
+ * first sample of the window to avoid cancellation). Energy is accumulated
+ * in joules (W.s) across windows.
+ *
+ * With 'cycles' set, windows are aligned to the voltage rising zero
+ * crossings and emitted every 'cycles' cycles ('window' is then the maximum
+ * window size, 0 for no limit). Samples before the first crossing are
+ * discarded. A window closed by the 'window' limit (e.g. voltage missing)
+ * doesn't end at a crossing: the samples up to the next crossing are not
+ * whole cycles, and are discarded (only their energy is accumulated), so
+ * the next window is aligned again and measures whole cycles only.
+ */
+template<typename VoltageSensor,
+         typename CurrentSensor,
+         typename T = double>
+class power_meter {
+ public:
+  using value_type = T;
+  using result_type = power_result<T>;
+
+  struct config {
+    std::uint32_t voltage_channel;
+    std::uint32_t current_channel;
+    double        sample_freq;          // per channel [Hz]
+    double        skew = 0.5;
+    std::size_t   window = 0;           // samples per result, 0 never emits
+    std::size_t   cycles = 0;           // cycles per result, 0 disables
+    double        hysteresis = 0;       // zero crossing hysteresis [V]
+  };
+
+  /**
+   * Skew of the current sample of a 'channels' entries pattern
+   */
+  [[nodiscard]] static constexpr double
+  skew(std::size_t voltage_index,
+       std::size_t current_index,
+       std::size_t channels) noexcept {
+    return static_cast<double>((current_index + channels - voltage_index) % channels)
+            / channels;
+  }
+
+  power_meter(const config& cfg,
+              const VoltageSensor& voltage = {},
+              const CurrentSensor& current = {}) noexcept
+   : cfg_(cfg), voltage_(voltage), current_(current),
+     detector_(cfg.sample_freq, static_cast<value_type>(cfg.hysteresis)) {}
+
+  /**
+   * Pushes a voltage/current pair already aligned in time
+   */
+  template<typename Callback>
+  void push(value_type v, value_type i, Callback&& callback) noexcept {
+    if (cfg_.cycles != 0) {
+      bool const rising = detector_.push(v - reference_v_);
+      if (!synced_) {
+        if (!rising)
+          return;
+        synced_ = aligned_ = true;
+        window_begin_ = detector_.last_crossing();
+      } else {
+        bool const full = cfg_.window != 0 && count_ == cfg_.window;
+        if ((rising && aligned_ && ++cycles_ == cfg_.cycles) || full) {
+          emit(callback);
+          // Only a crossing of this sample begins the next window
+          aligned_ = rising;
+          window_begin_ = detector_.last_crossing();
+        } else if (rising && !aligned_) {
+          discard();
+          aligned_ = true;
+          window_begin_ = detector_.last_crossing();
+        }
+      }
+    }
+
+    if (count_ == 0) {
+      shift_v_ = v;
+      shift_i_ = i;
+    }
+    v -= shift_v_;
+    i -= shift_i_;
+    sum_v_ += v;
+    sum_i_ += i;
+    sum_vv_ += v * v;
+    sum_ii_ += i * i;
+    sum_vi_ += v * i;
+    if (++count_ == cfg_.window && cfg_.cycles == 0)
+      emit(callback);
+  }
+
+  /**
+   * Pushes interleaved raw ADC records. Other channels are ignored.
+   */
+  template<typename Accessor = channel_access,
+           typename Iter,
+           typename Callback>
+  void process(Iter begin, Iter end, Callback&& callback) noexcept {
+    while (begin != end) {
+      auto const channel = Accessor::channel(*begin);
+      if (channel == cfg_.voltage_channel) {
+        value_type const v = voltage_(Accessor::get(*begin));
+        if (has_current_ && has_voltage_) {
+          value_type const aligned = last_v_ + cfg_.skew * (v - last_v_);
+          push(aligned, pending_i_, callback);
+        }
+        has_current_ = false;
+        has_voltage_ = true;
+        last_v_ = v;
+      } else if (channel == cfg_.current_channel) {
+        if (has_current_)
+          ++dropped_;
+        pending_i_ = current_(Accessor::get(*begin));
+        has_current_ = true;
+      }
+      ++begin;
+    }
+  }
+
+  /**
+   * Result of the current (not emitted) window
+   */
+  [[nodiscard]] result_type
+  result() const noexcept {
+    result_type r;
+    r.samples = count_;
+    if (count_ == 0)
+      return r;
+
+    value_type const n = static_cast<value_type>(count_);
+    value_type const mv = sum_v_ / n, mi = sum_i_ / n;
+    r.voltage_rms = std::sqrt(std::max(sum_vv_ / n - mv * mv, value_type(0)));
+    r.current_rms = std::sqrt(std::max(sum_ii_ / n - mi * mi, value_type(0)));
+    r.active = sum_vi_ / n - mv * mi;
+    r.apparent = r.voltage_rms * r.current_rms;
+    r.reactive = std::sqrt(std::max(r.apparent * r.apparent - r.active * r.active,
+                                    value_type(0)));
+    r.power_factor = r.apparent != 0 ? r.active / r.apparent : 0;
+    if (cfg_.cycles != 0 && cycles_ != 0)
+      r.frequency = cfg_.sample_freq * cycles_ /
+                      (detector_.last_crossing() - window_begin_);
+    return r;
+  }
+
+  /**
+   * Accumulated energy of all emitted windows [J]
+   */
+  [[nodiscard]] value_type
+  energy() const noexcept {
+    return energy_;
+  }
+
+  /**
+   * Current samples discarded because no voltage sample followed them
+   */
+  [[nodiscard]] std::size_t
+  dropped() const noexcept {
+    return dropped_;
+  }
+
+  void reset_energy() noexcept {
+    energy_ = 0;
+  }
+
+  void reset() noexcept {
+    clear();
+    energy_ = 0;
+    dropped_ = 0;
+    has_voltage_ = has_current_ = false;
+    detector_.reset();
+    reference_v_ = 0;
+    synced_ = aligned_ = false;
+  }
+
+ private:
+  template<typename Callback>
+  void emit(Callback&& callback) noexcept {
+    auto const r = result();
+    energy_ += r.active * (r.samples / cfg_.sample_freq);
+    callback(r);
+    reference_v_ = shift_v_ + sum_v_ / count_;
+    clear();
+  }
+
+  /**
+   * Clears the window, keeping its energy
+   */
+  void discard() noexcept {
+    if (count_ != 0)
+      energy_ += result().active * (count_ / cfg_.sample_freq);
+    clear();
+  }
+
+  void clear() noexcept {
+    sum_v_ = sum_i_ = sum_vv_ = sum_ii_ = sum_vi_ = 0;
+    count_ = 0;
+    cycles_ = 0;
+  }
+
+  config        cfg_;
+  VoltageSensor voltage_;
+  CurrentSensor current_;
+
+  value_type    shift_v_ = 0, shift_i_ = 0;
+  value_type    sum_v_ = 0, sum_i_ = 0;
+  value_type    sum_vv_ = 0, sum_ii_ = 0, sum_vi_ = 0;
+  std::size_t   count_ = 0;
+
+  value_type    last_v_ = 0;
+  value_type    pending_i_ = 0;
+  bool          has_voltage_ = false;
+  bool          has_current_ = false;
+
+  value_type    energy_ = 0;
+  std::size_t   dropped_ = 0;
+
+  zero_crossing<value_type> detector_;
+  value_type    reference_v_ = 0;     // Voltage DC of the last window
+  double        window_begin_ = 0;    // Crossing that started the window
+  std::size_t   cycles_ = 0;
+  bool          synced_ = false;
+  bool          aligned_ = false;     // window_begin_ is of this window
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_POWER_HPP_
@@ -0,0 +1,164 @@
+/**
+ * @file sensor.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Compile time sensor calibration profiles
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A profile is any structural type with constexpr gain() and offset(),
+ * mapping an ADC reading to the measured unit: offset + gain * reading.
+ * All the front-end constants are folded at compile time, so a conversion
+ * is a single multiply-add (or a table lookup).
+ *
+ * static constexpr wave::current_transformer my_ct{.rb = 33, .n2 = 1000};
+ * wave::convert(begin, end, out, wave::sensor<my_ct, float, true>{});
+ */
+#ifndef COMPONENTS_WAVE_SENSOR_HPP_
+#define COMPONENTS_WAVE_SENSOR_HPP_
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <algorithm>
+#include <type_traits>
+
+#include "wave/fixed_point.hpp"
+
+namespace wave {
+
+/**
+ * Current transformer with burden resistor, biased by a voltage divider
+ */
+struct current_transformer {
+  double vmax = 2.450;          // Maximum voltage ADC can read [V];
+  double vmin = 0.120;          // Minimum voltage ADC can read [V];
+  int d_max = 2895;             // Max decimal value correlated with Vmax on 12 bit range;
+  double vdc = 3.3;             // Voltage divisor supply [V];
+  double r1 = 180.0 * 1000;     // Voltage divisor top resistor [Ohms];
+  double r2 = 120.0 * 1000;     // Voltage divisor bottom resistor [Ohms];
+  double rb = 120.0;            // Burden resistor (bias) [Ohms];
+  double n1 = 1;                // Current transformer sensor ration parameters
+  double n2 = 2000;             // Current transformer sensor ration parameters
+
+  // Voltage over R2 [V] or Vref for ADC converter [V];
+  [[nodiscard]] constexpr double
+  vref() const noexcept {
+    return r2 / (r1 + r2) * vdc;
+  }
+
+  [[nodiscard]] constexpr double
+  gain() const noexcept {
+    return (vmax - vmin) / d_max / rb * (n2 / n1);
+  }
+
+  [[nodiscard]] constexpr double
+  offset() const noexcept {
+    return (vmin - vref()) / rb * (n2 / n1);
+  }
+};
+
+/**
+ * Voltage front-end: divider (or transformer) ratio over a biased ADC input
+ */
+struct voltage_divider {
+  double vmax = 2.450;          // Maximum voltage ADC can read [V];
+  double vmin = 0.120;          // Minimum voltage ADC can read [V];
+  int d_max = 2895;             // Max decimal value correlated with Vmax on 12 bit range;
+  double vbias = 1.32;          // Bias voltage at ADC input [V];
+  double ratio = 1;             // Measured voltage / ADC input voltage
+
+  [[nodiscard]] constexpr double
+  gain() const noexcept {
+    return (vmax - vmin) / d_max * ratio;
+  }
+
+  [[nodiscard]] constexpr double
+  offset() const noexcept {
+    return (vmin - vbias) * ratio;
+  }
+};
+
+/**
+ * Already computed gain and offset
+ */
+struct linear {
+  double gain_ = 1;
+  double offset_ = 0;
+
+  [[nodiscard]] constexpr double
+  gain() const noexcept { return gain_; }
+
+  [[nodiscard]] constexpr double
+  offset() const noexcept { return offset_; }
+};
+
+namespace detail {
+
+template<auto Params, typename T>
+struct sensor_compute {
+  static constexpr const double gain = Params.gain();
+  static constexpr const double offset = Params.offset();
+
+  template<typename U>
+  [[nodiscard]] static constexpr T
+  apply(U reading) noexcept {
+    if constexpr (is_fixed_v<T>) {
+      constexpr auto g = multiplier::make(gain);
+      constexpr auto o = T::from_double(offset);
+      return numeric<T>::affine(g, o, static_cast<std::int64_t>(reading));
+    } else
+      return static_cast<T>(offset + gain * reading);
+  }
+};
+
+static constexpr const std::size_t sensor_table_size = 4096;
+
+template<auto Params, typename T>
+inline constexpr const std::array<T, sensor_table_size> sensor_table = [] {
+  std::array<T, sensor_table_size> t{};
+  for (std::size_t i = 0; i < sensor_table_size; ++i)
+    t[i] = sensor_compute<Params, T>::apply(i);
+  return t;
+}();
+
+}  // namespace detail
+
+/**
+ * Converts ADC readings to T using the profile Params.
+ *
+ * UseTable precomputes all 'table_size' (12 bits) readings at compile time
+ * (table_size * sizeof(T) bytes of flash). Readings out of the table are
+ * clamped.
+ */
+template<auto Params,
+         typename T = double,
+         bool UseTable = false>
+struct sensor {
+  using value_type = T;
+  static constexpr const std::size_t table_size = detail::sensor_table_size;
+
+  static constexpr const double gain = Params.gain();
+  static constexpr const double offset = Params.offset();
+
+  template<typename U>
+  [[nodiscard]] constexpr value_type
+  operator()(U reading) const noexcept {
+    if constexpr (UseTable) {
+      return detail::sensor_table<Params, T>[
+                std::min(static_cast<std::size_t>(reading), table_size - 1)];
+    } else
+      return detail::sensor_compute<Params, T>::apply(reading);
+  }
+};
+
+static constexpr const current_transformer default_current_transformer{};
+
+template<typename T = double>
+using default_sensor = sensor<default_current_transformer, T>;
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_SENSOR_HPP_
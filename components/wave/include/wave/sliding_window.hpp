@@ -0,0 +1,296 @@
+/**
+ * @file sliding_window.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Statistics of the last N samples with O(1) updates
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * wave::sliding_stats<512, float> window;
+ * window.push(begin, end);
+ * if (window.crest_factor() > 2) ...
+ */
+#ifndef COMPONENTS_WAVE_SLIDING_WINDOW_HPP_
+#define COMPONENTS_WAVE_SLIDING_WINDOW_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "wave.hpp"
+
+namespace wave {
+
+/**
+ * Extreme (as defined by Compare) of the last N samples.
+ *
+ * Monotonic deque over a fixed ring: a sample is dropped as soon as a newer
+ * one is at least as extreme, so each sample is inserted and removed once
+ * (amortized O(1) per push, at most N entries).
+ */
+template<std::size_t N, typename T, typename Compare>
+class sliding_extreme {
+ public:
+  using value_type = T;
+  static constexpr const std::size_t capacity = N;
+
+  static_assert(N > 0, "Window must have at least one sample");
+
+  void push(value_type x) noexcept {
+    while (size_ != 0 && !Compare{}(back().value, x))
+      --size_;
+    if (size_ != 0 && front().index + N <= count_) {
+      head_ = next(head_);
+      --size_;
+    }
+    ring_[at(size_)] = {count_, x};
+    ++size_;
+    ++count_;
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void push(Iter begin, Iter end) noexcept {
+    while (begin != end) {
+      push(static_cast<value_type>(Accessor::get(*begin)));
+      ++begin;
+    }
+  }
+
+  /**
+   * Undefined if no sample was pushed
+   */
+  [[nodiscard]] value_type
+  value() const noexcept {
+    return front().value;
+  }
+
+  [[nodiscard]] bool
+  empty() const noexcept {
+    return count_ == 0;
+  }
+
+  void reset() noexcept {
+    head_ = size_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  struct entry {
+    std::uint64_t index;
+    value_type    value;
+  };
+
+  static constexpr std::size_t
+  next(std::size_t i) noexcept {
+    return i + 1 == N ? 0 : i + 1;
+  }
+
+  constexpr std::size_t
+  at(std::size_t offset) const noexcept {
+    std::size_t const i = head_ + offset;
+    return i >= N ? i - N : i;
+  }
+
+  const entry&
+  front() const noexcept {
+    return ring_[head_];
+  }
+
+  const entry&
+  back() const noexcept {
+    return ring_[at(size_ - 1)];
+  }
+
+  std::array<entry, N>  ring_{};
+  std::size_t           head_ = 0;
+  std::size_t           size_ = 0;
+  std::uint64_t         count_ = 0;
+};
+
+template<std::size_t N, typename T = double>
+using sliding_max = sliding_extreme<N, T, std::greater<T>>;
+
+template<std::size_t N, typename T = double>
+using sliding_min = sliding_extreme<N, T, std::less<T>>;
+
+/**
+ * Sum and sum of squares of the last N samples.
+ *
+ * Floating point sums are recomputed from the ring every N samples, so the
+ * add/subtract rounding error doesn't build up (still O(1) amortized).
+ */
+template<std::size_t N, typename T = double>
+class sliding_sum {
+ public:
+  using value_type = T;
+  using sum_type = std::conditional_t<std::is_floating_point_v<T>,
+                                      T, std::int64_t>;
+  static constexpr const std::size_t capacity = N;
+
+  static_assert(N > 0, "Window must have at least one sample");
+
+  void push(value_type x) noexcept {
+    if (size_ == N) {
+      sum_type const old = ring_[index_];
+      sum_ -= old;
+      sum_square_ -= old * old;
+    } else
+      ++size_;
+
+    ring_[index_] = x;
+    sum_ += static_cast<sum_type>(x);
+    sum_square_ += static_cast<sum_type>(x) * static_cast<sum_type>(x);
+    if (++index_ == N) {
+      index_ = 0;
+      if constexpr (std::is_floating_point_v<T>)
+        resync();
+    }
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void push(Iter begin, Iter end) noexcept {
+    while (begin != end) {
+      push(static_cast<value_type>(Accessor::get(*begin)));
+      ++begin;
+    }
+  }
+
+  [[nodiscard]] sum_type
+  sum() const noexcept {
+    return sum_;
+  }
+
+  [[nodiscard]] sum_type
+  sum_square() const noexcept {
+    return sum_square_;
+  }
+
+  /**
+   * Samples inside the window (N once full)
+   */
+  [[nodiscard]] std::size_t
+  size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool
+  full() const noexcept {
+    return size_ == N;
+  }
+
+  void reset() noexcept {
+    sum_ = sum_square_ = 0;
+    index_ = size_ = 0;
+  }
+
+ private:
+  void resync() noexcept {
+    sum_ = sum_square_ = 0;
+    for (std::size_t i = 0; i < size_; ++i) {
+      sum_ += ring_[i];
+      sum_square_ += ring_[i] * ring_[i];
+    }
+  }
+
+  std::array<value_type, N> ring_{};
+  sum_type                  sum_ = 0;
+  sum_type                  sum_square_ = 0;
+  std::size_t               index_ = 0;
+  std::size_t               size_ = 0;
+};
+
+/**
+ * Min, max, peak, mean, RMS and crest factor of the last N samples.
+ *
+ * The statistics refer to the samples as pushed: remove the DC component
+ * before (e.g. wave::dc_blocker) for AC peak/RMS/crest factor.
+ */
+template<std::size_t N, typename T = double>
+class sliding_stats {
+ public:
+  using value_type = T;
+  static constexpr const std::size_t capacity = N;
+
+  void push(value_type x) noexcept {
+    max_.push(x);
+    min_.push(x);
+    sum_.push(x);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  void push(Iter begin, Iter end) noexcept {
+    while (begin != end) {
+      push(static_cast<value_type>(Accessor::get(*begin)));
+      ++begin;
+    }
+  }
+
+  [[nodiscard]] value_type
+  min() const noexcept {
+    return min_.value();
+  }
+
+  [[nodiscard]] value_type
+  max() const noexcept {
+    return max_.value();
+  }
+
+  /**
+   * Maximum absolute value
+   */
+  [[nodiscard]] double
+  peak() const noexcept {
+    return std::max(std::abs(static_cast<double>(max())),
+                    std::abs(static_cast<double>(min())));
+  }
+
+  [[nodiscard]] double
+  mean() const noexcept {
+    return static_cast<double>(sum_.sum()) / sum_.size();
+  }
+
+  [[nodiscard]] double
+  rms() const noexcept {
+    return std::sqrt(static_cast<double>(sum_.sum_square()) / sum_.size());
+  }
+
+  /**
+   * Peak / RMS (sqrt(2) for a sine). 0 if RMS is 0.
+   */
+  [[nodiscard]] double
+  crest_factor() const noexcept {
+    double const r = rms();
+    return r != 0 ? peak() / r : 0;
+  }
+
+  [[nodiscard]] std::size_t
+  size() const noexcept {
+    return sum_.size();
+  }
+
+  [[nodiscard]] bool
+  full() const noexcept {
+    return sum_.full();
+  }
+
+  void reset() noexcept {
+    max_.reset();
+    min_.reset();
+    sum_.reset();
+  }
+
+ private:
+  sliding_max<N, T> max_;
+  sliding_min<N, T> min_;
+  sliding_sum<N, T> sum_;
+};
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_SLIDING_WINDOW_HPP_
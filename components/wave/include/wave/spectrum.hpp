@@ -0,0 +1,270 @@
+/**
+ * @file spectrum.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Harmonic analysis: Goertzel bank and radix-2 real FFT
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_WAVE_SPECTRUM_HPP_
+#define COMPONENTS_WAVE_SPECTRUM_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <complex>
+#include <numbers>
+#include <type_traits>
+
+#include "wave.hpp"
+
+namespace wave {
+
+/**
+ * Goertzel bank: computes Bins DFT bins in one pass over the samples.
+ * Frequencies don't need to be integer bins.
+ */
+template<std::size_t Bins, typename T = float>
+class goertzel_bank {
+ public:
+  using value_type = T;
+
+  static_assert(Bins > 0, "At least one bin must be defined");
+  static_assert(std::is_floating_point_v<T>, "Must be a floating point type");
+
+  goertzel_bank() noexcept = default;
+
+  /**
+   * Frequencies in Hz, sampled at 'sample_freq' Hz
+   */
+  goertzel_bank(const std::array<double, Bins>& frequencies,
+                double sample_freq) noexcept {
+    set(frequencies, sample_freq);
+  }
+
+  void set(const std::array<double, Bins>& frequencies,
+           double sample_freq) noexcept {
+    for (std::size_t i = 0; i < Bins; ++i) {
+      double const w = 2 * std::numbers::pi * frequencies[i] / sample_freq;
+      cos_[i] = static_cast<T>(std::cos(w));
+      sin_[i] = static_cast<T>(std::sin(w));
+      coeff_[i] = 2 * cos_[i];
+    }
+  }
+
+  /**
+   * Subtracts 'offset' (e.g. the DC component) from every sample and
+   * returns the DFT of each bin.
+   */
+  template<typename Accessor = access, typename Iter>
+  std::array<std::complex<T>, Bins>
+  process(Iter begin, Iter end, T offset = 0) const noexcept {
+    std::array<T, Bins> s1{}, s2{};
+    while (begin != end) {
+      T const x = static_cast<T>(Accessor::get(*begin)) - offset;
+      for (std::size_t i = 0; i < Bins; ++i) {
+        T const s = x + coeff_[i] * s1[i] - s2[i];
+        s2[i] = s1[i];
+        s1[i] = s;
+      }
+      ++begin;
+    }
+
+    std::array<std::complex<T>, Bins> out;
+    for (std::size_t i = 0; i < Bins; ++i)
+      out[i] = {s1[i] - s2[i] * cos_[i], s2[i] * sin_[i]};
+    return out;
+  }
+
+ private:
+  std::array<T, Bins> coeff_{};
+  std::array<T, Bins> cos_{};
+  std::array<T, Bins> sin_{};
+};
+
+/**
+ * Radix-2 FFT of N real samples, computed as a N/2 complex FFT plus a
+ * split step. Twiddles and the bit reverse permutation are computed once,
+ * at construction.
+ *
+ * Memory: N/2 complex twiddles + N/2 indexes + N/2 complex work buffer.
+ */
+template<std::size_t N, typename T = float>
+class real_fft {
+ public:
+  using value_type = T;
+  using complex_type = std::complex<T>;
+  using output_type = std::array<complex_type, N / 2 + 1>;
+  static constexpr const std::size_t size = N;
+
+  static_assert(N >= 4 && (N & (N - 1)) == 0, "Size must be a power of 2");
+  static_assert(N / 2 <= 65536, "Size too big to index");
+  static_assert(std::is_floating_point_v<T>, "Must be a floating point type");
+
+  real_fft() noexcept {
+    for (std::size_t k = 0; k < N / 2; ++k) {
+      double const w = -2 * std::numbers::pi * k / N;
+      twiddle_[k] = {static_cast<T>(std::cos(w)), static_cast<T>(std::sin(w))};
+    }
+
+    constexpr std::size_t half = N / 2;
+    std::size_t bits = 0;
+    while ((std::size_t(1) << bits) < half) ++bits;
+    for (std::size_t i = 0; i < half; ++i) {
+      std::size_t r = 0;
+      for (std::size_t b = 0; b < bits; ++b)
+        r |= ((i >> b) & 1) << (bits - 1 - b);
+      reverse_[i] = static_cast<std::uint16_t>(r);
+    }
+  }
+
+  /**
+   * Transforms the first N samples of [begin, ...) subtracting 'offset'.
+   * Output bins k = 0..N/2, at frequency k * sample_freq / N.
+   */
+  template<typename Accessor = access, typename Iter>
+  void transform(Iter begin, output_type& out, T offset = 0) noexcept {
+    constexpr std::size_t half = N / 2;
+    for (std::size_t n = 0; n < half; ++n) {
+      T const re = static_cast<T>(Accessor::get(*begin)) - offset;
+      ++begin;
+      T const im = static_cast<T>(Accessor::get(*begin)) - offset;
+      ++begin;
+      work_[reverse_[n]] = {re, im};
+    }
+
+    for (std::size_t len = 2; len <= half; len <<= 1) {
+      std::size_t const step = N / len;
+      std::size_t const mid = len / 2;
+      for (std::size_t i = 0; i < half; i += len) {
+        for (std::size_t j = 0; j < mid; ++j) {
+          complex_type const t = twiddle_[j * step] * work_[i + j + mid];
+          work_[i + j + mid] = work_[i + j] - t;
+          work_[i + j] += t;
+        }
+      }
+    }
+
+    out[0] = {work_[0].real() + work_[0].imag(), 0};
+    out[half] = {work_[0].real() - work_[0].imag(), 0};
+    for (std::size_t k = 1; k < half; ++k) {
+      complex_type const z = work_[k];
+      complex_type const zc = std::conj(work_[half - k]);
+      complex_type const even = (z + zc) * T(0.5);
+      complex_type const odd = (z - zc) * complex_type(0, T(-0.5));
+      out[k] = even + twiddle_[k] * odd;
+    }
+  }
+
+ private:
+  std::array<complex_type, N / 2>   twiddle_;
+  std::array<std::uint16_t, N / 2>  reverse_;
+  std::array<complex_type, N / 2>   work_;
+};
+
+/**
+ * Amplitude of each harmonic (index 0 is the fundamental) and the total
+ * harmonic distortion, relative to the fundamental.
+ */
+template<std::size_t Harmonics, typename T = float>
+struct harmonic_result {
+  std::array<T, Harmonics> amplitude{};
+  T                        thd = 0;
+
+  [[nodiscard]] T
+  rms(std::size_t harmonic) const noexcept {
+    return amplitude[harmonic] / std::numbers::sqrt2_v<T>;
+  }
+};
+
+template<std::size_t Harmonics, typename T>
+[[nodiscard]] T
+thd(const std::array<T, Harmonics>& amplitude) noexcept {
+  static_assert(Harmonics > 1, "At least one harmonic must be defined");
+  if (amplitude[0] == 0)
+    return 0;
+  T sum = 0;
+  for (std::size_t i = 1; i < Harmonics; ++i)
+    sum += amplitude[i] * amplitude[i];
+  return std::sqrt(sum) / amplitude[0];
+}
+
+/**
+ * Harmonic analysis up to the 'Harmonics' harmonic (1 is the fundamental)
+ * with a Goertzel bank.
+ *
+ * Each call does two passes: the mean (DC) and the bank. The result is
+ * exact when the range holds an integer number of fundamental cycles.
+ */
+template<std::size_t Harmonics = 15, typename T = float>
+class harmonic_analyzer {
+ public:
+  using result_type = harmonic_result<Harmonics, T>;
+
+  harmonic_analyzer(double fundamental, double sample_freq) noexcept {
+    set(fundamental, sample_freq);
+  }
+
+  void set(double fundamental, double sample_freq) noexcept {
+    std::array<double, Harmonics> freqs;
+    for (std::size_t i = 0; i < Harmonics; ++i)
+      freqs[i] = fundamental * (i + 1);
+    bank_.set(freqs, sample_freq);
+  }
+
+  template<typename Accessor = access, typename Iter>
+  result_type
+  operator()(Iter begin, Iter end) const noexcept {
+    std::size_t size = 0;
+    T sum = 0;
+    for (Iter it = begin; it != end; ++it, ++size)
+      sum += static_cast<T>(Accessor::get(*it));
+
+    result_type result;
+    if (size == 0)
+      return result;
+
+    auto const bins = bank_.template process<Accessor>(begin, end, sum / size);
+    for (std::size_t i = 0; i < Harmonics; ++i)
+      result.amplitude[i] = 2 * std::abs(bins[i]) / size;
+    result.thd = thd(result.amplitude);
+    return result;
+  }
+
+ private:
+  goertzel_bank<Harmonics, T> bank_;
+};
+
+/**
+ * Harmonic amplitudes from a real_fft output, with the fundamental at
+ * 'fundamental_bin'. Each harmonic takes the peak of its bin and the
+ * neighbours, to absorb small frequency deviations.
+ */
+template<std::size_t Harmonics = 15, typename T, std::size_t Bins>
+[[nodiscard]] harmonic_result<Harmonics, T>
+harmonics(const std::array<std::complex<T>, Bins>& spectrum,
+          std::size_t fundamental_bin) noexcept {
+  constexpr std::size_t n = (Bins - 1) * 2;
+  harmonic_result<Harmonics, T> result;
+  for (std::size_t i = 0; i < Harmonics; ++i) {
+    std::size_t const k = fundamental_bin * (i + 1);
+    if (k >= Bins)
+      break;
+    T peak = std::abs(spectrum[k]);
+    if (k > 1)
+      peak = std::max(peak, std::abs(spectrum[k - 1]));
+    if (k + 1 < Bins)
+      peak = std::max(peak, std::abs(spectrum[k + 1]));
+    result.amplitude[i] = 2 * peak / n;
+  }
+  result.thd = thd(result.amplitude);
+  return result;
+}
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_SPECTRUM_HPP_
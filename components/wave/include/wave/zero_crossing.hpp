@@ -0,0 +1,230 @@
+/**
+ * @file zero_crossing.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Zero crossing detection and per cycle frequency estimation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef COMPONENTS_WAVE_ZERO_CROSSING_HPP_
+#define COMPONENTS_WAVE_ZERO_CROSSING_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <limits>
+
+#include "wave.hpp"
+
+namespace wave {
+
+/**
+ * A full cycle between two rising crossings. Positions are fractional
+ * sample indexes counted from the first sample pushed to the detector.
+ */
+struct cycle {
+  double        begin;
+  double        end;
+  std::uint64_t begin_sample;     // First sample after 'begin'
+  std::uint64_t end_sample;       // First sample after 'end'
+
+  [[nodiscard]] constexpr double
+  period() const noexcept {
+    return end - begin;
+  }
+};
+
+/**
+ * Statistics of the detected periods (in samples)
+ */
+struct period_stats {
+  std::size_t cycles = 0;
+  double      mean = 0;
+  double      m2 = 0;
+  double      min = std::numeric_limits<double>::max();
+  double      max = 0;
+
+  void push(double period) noexcept {
+    ++cycles;
+    double const delta = period - mean;
+    mean += delta / cycles;
+    m2 += delta * (period - mean);
+    min = period < min ? period : min;
+    max = period > max ? period : max;
+  }
+
+  // Standard deviation of the period
+  [[nodiscard]] double
+  jitter() const noexcept {
+    return cycles > 1 ? std::sqrt(m2 / (cycles - 1)) : 0;
+  }
+};
+
+/**
+ * Rising zero crossing detector for a DC removed signal.
+ *
+ * The detector arms when the signal goes below -hysteresis and fires when
+ * it goes above +hysteresis. The crossing instant is the linear
+ * interpolation where the signal crossed zero, so the period resolution is
+ * a fraction of a sample.
+ */
+template<typename T = double>
+class zero_crossing {
+ public:
+  using value_type = T;
+
+  constexpr
+  zero_crossing(double sample_freq, value_type hysteresis = 0) noexcept
+   : sample_freq_(sample_freq), hysteresis_(hysteresis) {}
+
+  /**
+   * Returns true if a rising crossing was confirmed at this sample.
+   */
+  bool push(value_type x) noexcept {
+    bool fired = false;
+    if (samples_ != 0) {
+      if (armed_ && prev_ <= 0 && x > 0)
+        candidate_ = static_cast<double>(samples_ - 1) +
+                      static_cast<double>(prev_) / static_cast<double>(prev_ - x);
+      if (armed_ && x > hysteresis_ && candidate_ >= 0) {
+        armed_ = false;
+        fired = true;
+        if (last_ >= 0) {
+          cycle_ = {last_, candidate_, last_sample_,
+                    static_cast<std::uint64_t>(candidate_) + 1};
+          stats_.push(cycle_.period());
+          has_cycle_ = true;
+        }
+        last_ = candidate_;
+        last_sample_ = static_cast<std::uint64_t>(candidate_) + 1;
+        candidate_ = -1;
+      }
+    }
+    if (x < -hysteresis_) {
+      armed_ = true;
+      candidate_ = -1;
+    }
+    prev_ = x;
+    ++samples_;
+    return fired;
+  }
+
+  /**
+   * Calls on_cycle(const cycle&) for every full cycle completed in the
+   * range.
+   */
+  template<typename Accessor = access,
+           typename Iter,
+           typename Callback>
+  void process(Iter begin, Iter end, Callback&& on_cycle) noexcept {
+    while (begin != end) {
+      if (push(static_cast<value_type>(Accessor::get(*begin))) && has_cycle_)
+        on_cycle(cycle_);
+      ++begin;
+    }
+  }
+
+  /**
+   * Last full cycle. Only valid after two crossings.
+   */
+  [[nodiscard]] const cycle&
+  last_cycle() const noexcept {
+    return cycle_;
+  }
+
+  /**
+   * Position of the last confirmed crossing, -1 if none
+   */
+  [[nodiscard]] double
+  last_crossing() const noexcept {
+    return last_;
+  }
+
+  [[nodiscard]] bool
+  has_cycle() const noexcept {
+    return has_cycle_;
+  }
+
+  /**
+   * Frequency of the last full cycle [Hz]
+   */
+  [[nodiscard]] double
+  frequency() const noexcept {
+    return has_cycle_ ? sample_freq_ / cycle_.period() : 0;
+  }
+
+  [[nodiscard]] const period_stats&
+  stats() const noexcept {
+    return stats_;
+  }
+
+  /**
+   * Standard deviation of the period [s]
+   */
+  [[nodiscard]] double
+  jitter() const noexcept {
+    return stats_.jitter() / sample_freq_;
+  }
+
+  [[nodiscard]] double
+  sample_freq() const noexcept {
+    return sample_freq_;
+  }
+
+  [[nodiscard]] std::uint64_t
+  samples() const noexcept {
+    return samples_;
+  }
+
+  void reset_stats() noexcept {
+    stats_ = {};
+  }
+
+  void reset() noexcept {
+    *this = zero_crossing(sample_freq_, hysteresis_);
+  }
+
+ private:
+  double        sample_freq_;
+  value_type    hysteresis_;
+
+  value_type    prev_ = 0;
+  std::uint64_t samples_ = 0;
+  bool          armed_ = false;
+  double        candidate_ = -1;
+  double        last_ = -1;
+  std::uint64_t last_sample_ = 0;
+  cycle         cycle_{};
+  bool          has_cycle_ = false;
+  period_stats  stats_{};
+};
+
+/**
+ * Calls on_cycle(Iter cycle_begin, Iter cycle_end) for every full cycle
+ * inside [begin, end), so fixed buffers can be integrated over whole
+ * cycles only. 'offset' is the DC component to remove before detection.
+ */
+template<typename Accessor = access,
+         typename Iter,
+         typename Callback,
+         typename T = double>
+void for_each_cycle(Iter begin, Iter end,
+                    Callback&& on_cycle,
+                    T offset = 0, T hysteresis = 0) noexcept {
+  zero_crossing<T> detector(1, hysteresis);
+  Iter cycle_begin = end;
+  for (Iter it = begin; it != end; ++it) {
+    if (detector.push(static_cast<T>(Accessor::get(*it)) - offset)) {
+      if (cycle_begin != end)
+        on_cycle(cycle_begin, it);
+      cycle_begin = it;
+    }
+  }
+}
+
+}  // namespace wave
+
+#endif  // COMPONENTS_WAVE_ZERO_CROSSING_HPP_
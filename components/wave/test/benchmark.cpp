@@ -0,0 +1,431 @@
+/**
+ * @file benchmark.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief ns/sample and accuracy of the wave algorithms over several sizes
+ *        and numeric types
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Error is against a double precision reference on the same input:
+ * absolute for the sample domain rows (full scale is 1, maximum over the
+ * output for the filters), relative for the others. Filters are compared to
+ * direct form implementations (reference namespace), so the double rows
+ * show the rounding of the optimized forms. n/a: the row is itself the
+ * reference of another.
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "wave.hpp"
+#include "wave/accumulator.hpp"
+#include "wave/decimator.hpp"
+#include "wave/filter.hpp"
+#include "wave/power.hpp"
+#include "wave/sensor.hpp"
+#include "wave/sliding_window.hpp"
+#include "wave/spectrum.hpp"
+#include "wave/zero_crossing.hpp"
+
+#include "harness.hpp"
+
+static constexpr const std::array<std::size_t, 3> sizes{256, 1024, 4096};
+
+static constexpr const std::array<wave::biquad_coefficients<double>, 2> lowpass{{
+  {0.0200833656, 0.0401667312, 0.0200833656, -1.5610180758, 0.6413515381},
+  {0.0200833656, 0.0401667312, 0.0200833656, -1.5610180758, 0.6413515381}
+}};
+static constexpr const std::array<double, 8> taps{
+  0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125, 0.125
+};
+
+static constexpr const double first_order_weight = 0.8;
+static constexpr const std::size_t sliding_size = 256;
+static constexpr const std::size_t current_lag = 16;    // samples
+
+static constexpr const wave::linear unity{1, 0};
+
+static double min_time = 0.05;
+static constexpr const double not_available = NAN;
+
+static void
+row(const char* name, const char* type, std::size_t size, double ns, double error) {
+  if (std::isnan(error))
+    std::printf("%-22s %-8s %6zu %10.3f ns/sample  error n/a\n",
+                name, type, size, ns);
+  else
+    std::printf("%-22s %-8s %6zu %10.3f ns/sample  error %.3e\n",
+                name, type, size, ns, error);
+}
+
+static void
+row(const char* name, const char* type, std::size_t size,
+    double ns, double reference, double value, bool relative = true) {
+  row(name, type, size, ns, relative && reference != 0
+                             ? std::abs(value - reference) / std::abs(reference)
+                             : std::abs(value - reference));
+}
+
+template<typename T>
+static std::vector<T>
+input(std::size_t size) {
+  harness::signal const sig{.offset = 0, .amplitude = 0.5, .noise = 0.01,
+                            .harmonics = {0, 0.1, 0, 0.05}};
+  auto const data = sig.make<double>(size);
+  std::vector<T> out(size);
+  std::transform(data.begin(), data.end(), out.begin(), [](double v) {
+    if constexpr (wave::is_fixed_v<T>)
+      return T::from_double(v);
+    else
+      return static_cast<T>(v);
+  });
+  return out;
+}
+
+template<typename T>
+static double
+to_double(T v) noexcept {
+  if constexpr (wave::is_fixed_v<T>)
+    return v.to_double();
+  else
+    return static_cast<double>(v);
+}
+
+/**
+ * Largest absolute difference between 'value' and 'reference'
+ */
+template<typename T>
+static double
+max_error(const std::vector<T>& value, const std::vector<double>& reference) {
+  double error = 0;
+  for (std::size_t i = 0; i < std::min(value.size(), reference.size()); ++i)
+    error = std::max(error, std::abs(to_double(value[i]) - reference[i]));
+  return error;
+}
+
+/**
+ * Direct form, double precision, implementations of the filters
+ */
+namespace reference {
+
+static std::vector<double>
+first_order(const std::vector<double>& x, double w) {
+  std::vector<double> y(x.size());
+  for (std::size_t n = 0; n < x.size(); ++n)
+    y[n] = n == 0 ? x[0] : w * y[n - 1] + (1 - w) * x[n];
+  return y;
+}
+
+/**
+ * Direct form I of each section
+ */
+static std::vector<double>
+biquads(std::vector<double> x) {
+  for (auto const& c : lowpass) {
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (auto& v : x) {
+      double const y = c.b0 * v + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+      x2 = x1;
+      x1 = v;
+      y2 = y1;
+      y1 = y;
+      v = y;
+    }
+  }
+  return x;
+}
+
+/**
+ * Convolution with 'h', zero before the first sample. Only outputs of the
+ * samples 'at' + k * 'step'.
+ */
+template<typename Taps>
+static std::vector<double>
+convolve(const std::vector<double>& x, const Taps& h,
+         std::size_t step = 1, std::size_t at = 0) {
+  std::vector<double> y;
+  for (std::size_t n = at; n < x.size(); n += step) {
+    double acc = 0;
+    for (std::size_t k = 0; k < std::size(h) && k <= n; ++k)
+      acc += static_cast<double>(h[k]) * x[n - k];
+    y.push_back(acc);
+  }
+  return y;
+}
+
+static std::vector<double>
+dc_blocker(const std::vector<double>& x, double pole) {
+  std::vector<double> y(x.size());
+  double x1 = x.empty() ? 0 : x[0], y1 = 0;
+  for (std::size_t n = 0; n < x.size(); ++n) {
+    y[n] = x[n] - x1 + pole * y1;
+    x1 = x[n];
+    y1 = y[n];
+  }
+  return y;
+}
+
+/**
+ * Active power of the whole input, current lagging 'lag' samples
+ */
+static double
+active_power(const std::vector<double>& v, std::size_t lag) {
+  double sv = 0, si = 0, svi = 0;
+  for (std::size_t n = 0; n < v.size(); ++n) {
+    double const i = v[(n + lag) % v.size()];
+    sv += v[n];
+    si += i;
+    svi += v[n] * i;
+  }
+  double const count = static_cast<double>(v.size());
+  return svi / count - (sv / count) * (si / count);
+}
+
+}  // namespace reference
+
+/**
+ * Algorithms that run on any numeric type (including fixed point)
+ */
+template<typename T>
+static void
+numeric(const char* type, std::size_t size) {
+  auto const data = input<T>(size);
+  auto const reference = input<double>(size);
+
+  double result = 0;
+  double ns = harness::ns_per_sample(size, [&] {
+    result = to_double(wave::mean(data.begin(), data.end()));
+    harness::keep(result);
+  }, min_time);
+  row("mean", type, size, ns,
+      wave::mean(reference.begin(), reference.end()), result, false);
+
+  ns = harness::ns_per_sample(size, [&] {
+    result = to_double(wave::rms_sine(data.begin(), data.end()));
+    harness::keep(result);
+  }, min_time);
+  row("rms_sine", type, size, ns,
+      wave::rms_sine(reference.begin(), reference.end()), result, false);
+
+  auto work = data;
+  ns = harness::ns_per_sample(size, [&] {
+    std::copy(data.begin(), data.end(), work.begin());
+    wave::filter_first_order(work.begin(), work.end(), 0.8);
+    harness::keep(work[size - 1]);
+  }, min_time);
+  auto ref_work = reference;
+  wave::filter_first_order(ref_work.begin(), ref_work.end(), 0.8);
+  row("filter_first_order", type, size, ns, ref_work.back(), to_double(work.back()),
+      false);
+
+  // Welford accumulators are floating point only
+  if constexpr (std::is_floating_point_v<T>) {
+    wave::rms_accumulator<T> acc(wave::window::samples(size));
+    T last{};
+    ns = harness::ns_per_sample(size, [&] {
+      acc.push(data.begin(), data.end(), [&](const auto& r) { last = r.rms; });
+      harness::keep(last);
+    }, min_time);
+    wave::rms_accumulator<double> ref_acc(wave::window::samples(size));
+    double ref_last = 0;
+    ref_acc.push(reference.begin(), reference.end(),
+                 [&](const auto& r) { ref_last = r.rms; });
+    row("rms_accumulator", type, size, ns, ref_last, to_double(last), false);
+  }
+
+  wave::first_order<T> fo(first_order_weight);
+  ns = harness::ns_per_sample(size, [&] {
+    fo.process(work.begin(), work.end(), work.begin());
+    harness::keep(work[size - 1]);
+  }, min_time);
+  std::vector<T> single(size);
+  wave::first_order<T>(first_order_weight).process(data.begin(), data.end(),
+                                                   single.begin());
+  row("first_order", type, size, ns,
+      max_error(single, reference::first_order(reference, first_order_weight)));
+}
+
+/**
+ * Floating point only algorithms
+ */
+template<typename T>
+static void
+floating(const char* type, std::size_t size) {
+  auto const data = input<T>(size);
+  auto const reference = input<double>(size);
+  std::vector<T> out(size), single(size);
+
+  wave::biquad_cascade<lowpass, T> bq;
+  double ns = harness::ns_per_sample(size, [&] {
+    bq.process(data.begin(), data.end(), out.begin());
+    harness::keep(out[size - 1]);
+  }, min_time);
+  wave::biquad_cascade<lowpass, T>{}.process(data.begin(), data.end(), single.begin());
+  row("biquad_cascade<2>", type, size, ns,
+      max_error(single, reference::biquads(reference)));
+
+  wave::fir<taps, T> fir;
+  ns = harness::ns_per_sample(size, [&] {
+    fir.process(data.begin(), data.end(), out.begin());
+    harness::keep(out[size - 1]);
+  }, min_time);
+  wave::fir<taps, T>{}.process(data.begin(), data.end(), single.begin());
+  row("fir<8>", type, size, ns, max_error(single, reference::convolve(reference, taps)));
+
+  wave::dc_blocker<T> dc;
+  ns = harness::ns_per_sample(size, [&] {
+    dc.process(data.begin(), data.end(), out.begin());
+    harness::keep(out[size - 1]);
+  }, min_time);
+  wave::dc_blocker<T>{}.process(data.begin(), data.end(), single.begin());
+  row("dc_blocker", type, size, ns,
+      max_error(single, reference::dc_blocker(reference, static_cast<double>(T(0.995)))));
+
+  wave::decimator<13, 65, T> dec;
+  ns = harness::ns_per_sample(size, [&] {
+    harness::keep(*dec.process(data.begin(), data.end(), out.begin()));
+  }, min_time);
+  dec.reset();
+  single.resize(dec.process(data.begin(), data.end(), single.begin()) - single.begin());
+  // Kept outputs: the last sample of each Factor inputs
+  row("decimator<13, 65>", type, size, ns,
+      max_error(single, reference::convolve(reference, dec.coefficients(), 13, 12)));
+  single.resize(size);
+
+  wave::sliding_stats<sliding_size, T> sliding;
+  ns = harness::ns_per_sample(size, [&] {
+    sliding.push(data.begin(), data.end());
+    harness::keep(sliding.max());
+  }, min_time);
+  {
+    // Against a rescan of the last window of a single pass
+    wave::sliding_stats<sliding_size, T> fresh;
+    fresh.push(data.begin(), data.end());
+    auto const last = reference.end() - std::min(size, sliding_size);
+    auto const [lo, hi] = std::minmax_element(last, reference.end());
+    double square = 0;
+    for (auto it = last; it != reference.end(); ++it)
+      square += *it * *it;
+    double const rms = std::sqrt(square / (reference.end() - last));
+    row("sliding_stats<256>", type, size, ns,
+        std::max({std::abs(to_double(fresh.max()) - *hi),
+                  std::abs(to_double(fresh.min()) - *lo),
+                  std::abs(fresh.rms() - rms)}));
+  }
+
+  wave::zero_crossing<T> zc(7680, static_cast<T>(0.05));
+  ns = harness::ns_per_sample(size, [&] {
+    zc.process(data.begin(), data.end(), [](const wave::cycle& c) {
+      harness::keep(c);
+    });
+  }, min_time);
+  row("zero_crossing", type, size, ns, 60, zc.frequency());
+
+  wave::harmonic_analyzer<15, T> analyzer(60, 7680);
+  auto const ref_thd = std::hypot(0.1, 0.05);
+  T thd = 0;
+  ns = harness::ns_per_sample(size, [&] {
+    thd = analyzer(data.begin(), data.end()).thd;
+    harness::keep(thd);
+  }, min_time);
+  // Only whole cycles (128 samples) are exact
+  row("harmonic_analyzer<15>", type, size, ns, ref_thd, thd);
+
+  // One window per call: the whole input
+  using sensor = wave::sensor<unity, T>;
+  wave::power_meter<sensor, sensor, T> meter({.voltage_channel = 0,
+                                              .current_channel = 1,
+                                              .sample_freq = 7680,
+                                              .window = size});
+  T active = 0;
+  ns = harness::ns_per_sample(size, [&] {
+    for (std::size_t n = 0; n < size; ++n)
+      meter.push(data[n], data[(n + current_lag) % size],
+                 [&](const auto& r) { active = r.active; });
+    harness::keep(active);
+  }, min_time);
+  row("power_meter", type, size, ns,
+      reference::active_power(reference, current_lag), active);
+}
+
+template<typename T>
+static void
+fft(const char* type) {
+  constexpr std::size_t size = 1024;
+  auto const data = input<T>(size);
+  wave::real_fft<size, T> transform;
+  typename wave::real_fft<size, T>::output_type out;
+  double ns = harness::ns_per_sample(size, [&] {
+    transform.transform(data.begin(), out);
+    harness::keep(out[1]);
+  }, min_time);
+  row("real_fft<1024>", type, size, ns, std::hypot(0.1, 0.05),
+      wave::harmonics<15>(out, 8).thd);
+}
+
+static void
+pipeline(std::size_t size) {
+  auto const raw = harness::signal{.noise = 2}.make<std::uint32_t>(size);
+  std::vector<double> out(size);
+
+  double multi = 0, fused = 0;
+  auto work = raw;
+  double const ns_multi = harness::ns_per_sample(size, [&] {
+    std::copy(raw.begin(), raw.end(), work.begin());
+    wave::filter_first_order(work.begin(), work.end(), 0.8);
+    wave::convert(work.begin(), work.end(), out.begin());
+    wave::remove_constant(out.begin(), out.end(),
+                          wave::mean(out.begin(), out.end()));
+    multi = wave::rms_sine(out.begin(), out.end());
+    harness::keep(multi);
+  }, min_time);
+  // Reference of rms_sine_fused
+  row("multi pass rms", "uint32", size, ns_multi, not_available);
+
+  double const ns_fused = harness::ns_per_sample(size, [&] {
+    fused = wave::rms_sine_fused(raw.begin(), raw.end(), 0.8);
+    harness::keep(fused);
+  }, min_time);
+  row("rms_sine_fused", "uint32", size, ns_fused, multi, fused);
+
+  using table = wave::sensor<wave::default_current_transformer, float, true>;
+  double const ns_convert = harness::ns_per_sample(size, [&] {
+    wave::convert(raw.begin(), raw.end(), out.begin(), table{});
+    harness::keep(out[size - 1]);
+  }, min_time);
+  // Relative to the largest reading, computed in double
+  using computed = wave::sensor<wave::default_current_transformer, double>;
+  double error = 0, scale = 0;
+  for (std::size_t n = 0; n < size; ++n) {
+    double const expected = computed{}(raw[n]);
+    error = std::max(error, std::abs(out[n] - expected));
+    scale = std::max(scale, std::abs(expected));
+  }
+  row("convert (table)", "uint32", size, ns_convert, scale != 0 ? error / scale : error);
+}
+
+int main(int argc, char** argv) {
+  // --quick: minimal timing, used by ctest to check it runs
+  if (argc > 1 && std::strcmp(argv[1], "--quick") == 0)
+    min_time = 0;
+
+  for (std::size_t size : sizes) {
+    numeric<double>("double", size);
+    numeric<float>("float", size);
+    numeric<wave::q15>("q15", size);
+    numeric<wave::q31>("q31", size);
+    floating<double>("double", size);
+    floating<float>("float", size);
+    pipeline(size);
+  }
+  fft<double>("double");
+  fft<float>("float");
+  return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file fixed_point.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Compares throughput and error of fixed point wave algorithms
+ *        against the double versions
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "wave.hpp"
+
+#include "harness.hpp"
+
+static constexpr const std::size_t size = 1024;
+template<typename Func>
+static double
+ns_per_sample(Func&& func) {
+  return harness::ns_per_sample(size, std::forward<Func>(func));
+}
+
+static void
+report(const char* name, double ns_double, double ns_fixed,
+       double error, double bound) {
+  std::printf("%-28s double %7.3f ns/sample | fixed %7.3f ns/sample\n",
+              name, ns_double, ns_fixed);
+  harness::check(name, error, 0, bound);
+}
+
+template<typename Fixed>
+static void
+run(const char* type, const std::vector<double>& signal) {
+  double const lsb = Fixed::epsilon().to_double();
+  char name[64];
+
+  std::vector<Fixed> fsignal(size);
+  std::transform(signal.begin(), signal.end(), fsignal.begin(),
+                 [](double v) { return Fixed::from_double(v); });
+  double quantization = 0;
+  for (std::size_t i = 0; i < size; ++i)
+    quantization = std::max(quantization,
+                            std::abs(fsignal[i].to_double() - signal[i]));
+
+  {
+    double d = 0;
+    Fixed f{};
+    double nd = ns_per_sample([&] {
+      d = wave::mean(signal.begin(), signal.end());
+      harness::keep(d);
+    });
+    double nf = ns_per_sample([&] {
+      f = wave::mean(fsignal.begin(), fsignal.end());
+      harness::keep(f);
+    });
+    std::snprintf(name, sizeof(name), "%s mean", type);
+    report(name, nd, nf, std::abs(d - f.to_double()), quantization + lsb);
+  }
+  {
+    double d = 0;
+    Fixed f{};
+    double nd = ns_per_sample([&] {
+      d = wave::rms_sine(signal.begin(), signal.end());
+      harness::keep(d);
+    });
+    double nf = ns_per_sample([&] {
+      f = wave::rms_sine(fsignal.begin(), fsignal.end());
+      harness::keep(f);
+    });
+    std::snprintf(name, sizeof(name), "%s rms_sine", type);
+    report(name, nd, nf, std::abs(d - f.to_double()), quantization + 2 * lsb);
+  }
+  {
+    std::vector<double> d;
+    std::vector<Fixed> f;
+    double nd = ns_per_sample([&] {
+      d = signal;
+      wave::filter_first_order(d.begin(), d.end(), 0.8);
+    });
+    double nf = ns_per_sample([&] {
+      f = fsignal;
+      wave::filter_first_order(f.begin(), f.end(), 0.8);
+    });
+    double error = 0;
+    for (std::size_t i = 0; i < size; ++i)
+      error = std::max(error, std::abs(d[i] - f[i].to_double()));
+    // Rounding errors are attenuated by the filter: sum(0.8^n) = 5
+    std::snprintf(name, sizeof(name), "%s filter_first_order", type);
+    report(name, nd, nf, error, quantization + 5 * lsb);
+  }
+}
+
+int main() {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> noise(0, 0.01);
+
+  std::vector<double> signal(size);
+  std::vector<std::uint32_t> adc(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    double s = 0.1 + 0.6 * std::sin(2 * M_PI * 60 * i / 26000.0)
+                   + 0.05 * std::sin(2 * M_PI * 180 * i / 26000.0)
+                   + noise(gen);
+    signal[i] = s;
+    adc[i] = static_cast<std::uint32_t>(std::clamp(1447 + 1400 * s, 0.0, 4095.0));
+  }
+
+  run<wave::q15>("q15", signal);
+  run<wave::q31>("q31", signal);
+
+  {
+    using amp = wave::fixed<std::int32_t, 16>;
+    std::vector<double> d(size);
+    std::vector<amp> f(size);
+    double nd = ns_per_sample([&] {
+      wave::convert(adc.begin(), adc.end(), d.begin());
+    });
+    double nf = ns_per_sample([&] {
+      wave::convert(adc.begin(), adc.end(), f.begin());
+    });
+    double error = 0;
+    for (std::size_t i = 0; i < size; ++i)
+      error = std::max(error, std::abs(d[i] - f[i].to_double()));
+    report("q15.16 convert", nd, nf, error, amp::epsilon().to_double());
+  }
+
+  return harness::result();
+}
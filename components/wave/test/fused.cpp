@@ -0,0 +1,55 @@
+/**
+ * @file fused.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Checks wave::rms_sine_fused against the multi-pass pipeline
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "wave.hpp"
+
+#include "harness.hpp"
+
+static double
+multi_pass(std::vector<std::uint32_t> data, double weight) {
+  std::vector<double> out(data.size());
+  wave::filter_first_order(data.begin(), data.end(), weight);
+  wave::convert(data.begin(), data.end(), out.begin());
+  wave::remove_constant(out.begin(), out.end(),
+                        wave::mean(out.begin(), out.end()));
+  return wave::rms_sine(out.begin(), out.end());
+}
+
+int main() {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> noise(0, 8);
+
+  for (double amplitude : {10.0, 300.0, 1200.0}) {
+    for (std::size_t size : {2, 350, 1024}) {
+      std::vector<std::uint32_t> data(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        double v = 1447 + amplitude * std::sin(2 * M_PI * 60 * i / 26000.0)
+                        + noise(gen);
+        data[i] = static_cast<std::uint32_t>(std::clamp(v, 0.0, 4095.0));
+      }
+
+      for (double weight : {0.0, 0.8}) {
+        double const expected = multi_pass(data, weight);
+        double const result = wave::rms_sine_fused(data.begin(), data.end(), weight);
+        char name[64];
+        std::snprintf(name, sizeof(name), "amplitude=%.1f size=%zu weight=%.1f",
+                      amplitude, size, weight);
+        harness::check(name, result, expected, 1e-9 * std::max(1.0, expected));
+      }
+    }
+  }
+  return harness::result();
+}
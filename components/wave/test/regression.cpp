@@ -0,0 +1,527 @@
+/**
+ * @file regression.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Accuracy of every wave algorithm on synthetic sine, noise and
+ *        harmonic inputs
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "wave.hpp"
+#include "wave/accumulator.hpp"
+#include "wave/channel.hpp"
+#include "wave/decimator.hpp"
+#include "wave/filter.hpp"
+#include "wave/power.hpp"
+#include "wave/sliding_window.hpp"
+#include "wave/spectrum.hpp"
+#include "wave/zero_crossing.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+
+static constexpr const wave::linear unity{1, 0};
+using unity_sensor = wave::sensor<unity>;
+
+static constexpr const std::array<wave::biquad_coefficients<double>, 1> passthrough{{
+  {1, 0, 0, 0, 0}
+}};
+static constexpr const std::array<double, 3> moving_average{1. / 3, 1. / 3, 1. / 3};
+static constexpr const std::array<wave::biquad_coefficients<double>, 2> lowpass{{
+  {0.0200833656, 0.0401667312, 0.0200833656, -1.5610180758, 0.6413515381},
+  {0.0200833656, 0.0401667312, 0.0200833656, -1.5610180758, 0.6413515381}
+}};
+
+static void
+core() {
+  harness::signal const sig{.noise = 2};
+  auto const data = sig.make<double>(7680);
+
+  check("mean", wave::mean(data.begin(), data.end()), sig.offset, 0.1);
+
+  auto centered = data;
+  wave::remove_constant(centered.begin(), centered.end(),
+                        wave::mean(data.begin(), data.end()));
+  check("rms_sine (noise 2)", wave::rms_sine(centered.begin(), centered.end()),
+        std::hypot(sig.rms(), sig.noise), 0.1);
+
+  auto const raw = harness::signal{}.make<std::uint32_t>(7680);
+  std::vector<double> converted(raw.size());
+  wave::convert(raw.begin(), raw.end(), converted.begin(), unity_sensor{});
+  check("convert (unity)", converted[100], raw[100], 0);
+
+  std::vector<double> constant(64, 5.0);
+  wave::filter_first_order(constant.begin(), constant.end(), 0.8);
+  check("filter_first_order (constant)", constant.back(), 5.0, 1e-12);
+
+  check("rms_sine_fused (weight 0)",
+        wave::rms_sine_fused(raw.begin(), raw.end(), 0, unity_sensor{}),
+        harness::signal{}.rms(), 0.5);
+
+  std::vector<wave::q15> q(1024);
+  auto const small = harness::signal{.offset = 0, .amplitude = 0.5}.make<double>(q.size());
+  std::transform(small.begin(), small.end(), q.begin(),
+                 [](double v) { return wave::q15::from_double(v); });
+  check("rms_sine q15", wave::rms_sine(q.begin(), q.end()).to_double(),
+        0.5 / std::sqrt(2), 1e-3);
+}
+
+static void
+accumulators() {
+  harness::signal const sig{.offset = 10, .amplitude = 2};
+  auto const data = sig.make<double>(7680);
+
+  wave::rms_accumulator<double> rms(wave::window::samples(1280));
+  std::size_t windows = 0;
+  double last = 0;
+  rms.push(data.begin(), data.end(), [&](const auto& r) {
+    ++windows;
+    last = r.rms;
+  });
+  check("rms_accumulator windows", windows, 6, 0);
+  check("rms_accumulator rms", last, sig.rms(), 1e-9);
+
+  wave::mean_accumulator<double> mean(wave::window::cycles(5, 0.1));
+  double m = 0;
+  std::size_t samples = 0;
+  mean.push(data.begin(), data.end(), [&](const auto& r) {
+    m = r.mean;
+    samples = r.samples;
+  });
+  check("mean_accumulator cycles mean", m, sig.offset, 1e-3);
+  check("mean_accumulator cycles samples", samples, 5 * 128, 1);
+
+  // No crossing at all (DC, dead channel): emitted at max_samples
+  wave::rms_accumulator<double> dc(wave::window::cycles(5, 0.1, 1000));
+  std::size_t dc_windows = 0;
+  double dc_mean = 0, dc_rms = -1;
+  for (int i = 0; i < 3500; ++i)
+    dc.push(1.5, [&](const auto& r) {
+      ++dc_windows;
+      dc_mean = r.mean;
+      dc_rms = r.rms;
+      samples = r.samples;
+    });
+  check("cycles no crossing windows", dc_windows, 3, 0);
+  check("cycles no crossing samples", samples, 1000, 0);
+  check("cycles no crossing mean", dc_mean, 1.5, 1e-12);
+  check("cycles no crossing rms", dc_rms, 0, 1e-12);
+
+  // Input dead in the middle (back below the mean, no crossing at the
+  // step): after the max_samples window, the next ones must start at a
+  // crossing again (whole cycles only)
+  auto dropout = sig.make<double>(5120);
+  std::fill(dropout.begin() + 1280, dropout.begin() + 2000, sig.offset - 0.5);
+  wave::rms_accumulator<double> capped(wave::window::cycles(5, 0.1, 800));
+  std::size_t capped_windows = 0, after = 0, not_aligned = 0;
+  capped.push(dropout.begin(), dropout.end(), [&](const auto& r) {
+    if (r.samples == 800) {
+      ++capped_windows;
+      return;
+    }
+    if (capped_windows == 0)
+      return;
+    ++after;
+    not_aligned += r.samples < 5 * 128 - 2 || r.samples > 5 * 128 + 2 ||
+                   std::abs(r.rms - sig.rms()) > 1e-2;
+  });
+  check("cycles capped windows", capped_windows == 1 && after >= 3);
+  check("cycles realigned after cap", not_aligned == 0);
+}
+
+struct tagged {
+  int     tag;
+  double  v;
+};
+
+struct tagged_value {
+  static double& get(tagged& t) noexcept { return t.v; }
+  static const double& get(const tagged& t) noexcept { return t.v; }
+};
+
+/**
+ * Output of 'filter' over 'input' in frames of varying size equal to a
+ * single call
+ */
+template<typename Filter>
+static bool
+filtered_in_frames(Filter filter, const std::vector<double>& input) {
+  Filter whole = filter;
+  std::vector<double> expected(input.size()), out(input.size());
+  whole.process(input.begin(), input.end(), expected.begin());
+
+  static constexpr const std::array<std::size_t, 5> frames{1, 7, 64, 333, 2};
+  std::size_t at = 0;
+  for (std::size_t f = 0; at < input.size(); ++f) {
+    std::size_t const n = std::min(frames[f % frames.size()], input.size() - at);
+    filter.process(input.begin() + at, input.begin() + at + n, out.begin() + at);
+    at += n;
+  }
+  return out == expected;
+}
+
+static void
+filters() {
+  wave::biquad_cascade<passthrough, double> bq;
+  check("biquad passthrough", bq(3.5), 3.5, 0);
+
+  wave::fir<moving_average, double> f;
+  f(3);
+  f(6);
+  check("fir moving average", f(9), 6, 1e-12);
+
+  harness::signal const sig{.offset = 500, .amplitude = 100};
+  auto data = sig.make<double>(7680 * 2);
+  wave::dc_blocker<double> dc;
+  dc.process(data.begin(), data.end());
+  check("dc_blocker mean", wave::mean(data.end() - 7680, data.end()), 0, 0.5);
+
+  wave::first_order<double> fo(0.5);
+  fo(0);
+  check("first_order step", fo(1), 0.5, 0);
+
+  // Records filtered in place through a accessor, random access or not
+  std::vector<double> values{1, 4, 2, 8, 5, 7, 3, 6, 9, 0};
+  std::vector<tagged> records;
+  for (double v : values)
+    records.push_back({7, v});
+  std::list<tagged> linked(records.begin(), records.end());
+  wave::fir<moving_average, double>{}.process(values.begin(), values.end());
+  wave::fir<moving_average, double>{}.process<tagged_value>(records.begin(), records.end());
+  wave::fir<moving_average, double>{}.process<tagged_value>(linked.begin(), linked.end());
+  bool same = true;
+  auto it = linked.begin();
+  for (std::size_t n = 0; n < values.size(); ++n, ++it)
+    same = same && records[n].v == values[n] && records[n].tag == 7 &&
+           it->v == values[n] && it->tag == 7;
+  check("filter records in place", same);
+
+  // Frames of any size filter as one stream
+  harness::signal const noisy{.offset = 0, .amplitude = 1, .noise = 0.1,
+                              .harmonics = {0, 0.2}};
+  auto const input = noisy.make<double>(4096);
+  check("first_order frames", filtered_in_frames(wave::first_order<double>(0.8), input));
+  check("biquad_cascade frames", filtered_in_frames(wave::biquad_cascade<lowpass, double>{},
+                                                    input));
+  check("fir frames", filtered_in_frames(wave::fir<moving_average, double>{}, input));
+  check("dc_blocker frames", filtered_in_frames(wave::dc_blocker<double>{}, input));
+
+  // Direct form II transposed against direct form I
+  std::vector<double> out(input.size()), direct = input;
+  wave::biquad_cascade<lowpass, double>{}.process(input.begin(), input.end(), out.begin());
+  for (auto const& c : lowpass) {
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (auto& v : direct) {
+      double const y = c.b0 * v + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+      x2 = x1;
+      x1 = v;
+      y2 = y1;
+      y1 = y;
+      v = y;
+    }
+  }
+  double max_error = 0;
+  for (std::size_t n = 0; n < out.size(); ++n)
+    max_error = std::max(max_error, std::abs(out[n] - direct[n]));
+  check("biquad_cascade direct form", max_error, 0, 1e-12);
+}
+
+static void
+decimator() {
+  harness::signal const sig{.offset = 0, .amplitude = 1, .sample_freq = 26000};
+  auto const data = sig.make<double>(26000);
+  wave::decimator<13, 65, double> dec;
+  std::vector<double> out(dec.output_size(data.size()));
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < data.size(); i += 350) {
+    auto const e = data.begin() + std::min(data.size(), i + 350);
+    n = dec.process(data.begin() + i, e, out.begin() + n) - out.begin();
+  }
+  check("decimator outputs", n, 2000, 0);
+
+  // Same as the full rate FIR with only every Factor-th output kept
+  auto const& h = dec.coefficients();
+  double max_error = 0;
+  for (std::size_t m = 0; m < n; ++m) {
+    std::size_t const at = 13 * m + 12;
+    double y = 0;
+    for (std::size_t k = 0; k < h.size() && k <= at; ++k)
+      y += h[k] * data[at - k];
+    max_error = std::max(max_error, std::abs(y - out[m]));
+  }
+  check("decimator equal to FIR and downsample", max_error, 0, 1e-12);
+  // 30 cycles. 65 taps at Factor 13 give a wide transition band, ~0.3%
+  // droop at 60 Hz
+  check("decimator passband rms",
+        wave::rms_sine(out.begin() + 100, out.begin() + 1100),
+        sig.rms(), 4e-3);
+
+  harness::signal const alias{.offset = 0, .amplitude = 1,
+                              .frequency = 5000, .sample_freq = 26000};
+  auto const high = alias.make<double>(26000);
+  dec.reset();
+  n = dec.process(high.begin(), high.end(), out.begin()) - out.begin();
+  check("decimator stopband rms", wave::rms_sine(out.begin() + 100, out.begin() + n),
+        0, 1e-3);
+}
+
+/**
+ * Min, max, sum and sum of squares after every push, against a rescan of
+ * the last N samples
+ */
+template<std::size_t N, typename T>
+static void
+sliding_brute(const char* name, const std::vector<T>& data) {
+  wave::sliding_max<N, T> max;
+  wave::sliding_min<N, T> min;
+  wave::sliding_sum<N, T> sum;
+  std::size_t wrong = 0;
+  double sum_error = 0, square_error = 0;
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    max.push(data[i]);
+    min.push(data[i]);
+    sum.push(data[i]);
+
+    std::size_t const first = i + 1 > N ? i + 1 - N : 0;
+    auto const [lo, hi] = std::minmax_element(data.begin() + first,
+                                              data.begin() + i + 1);
+    double s = 0, s2 = 0;
+    for (std::size_t j = first; j <= i; ++j) {
+      s += data[j];
+      s2 += static_cast<double>(data[j]) * data[j];
+    }
+    wrong += max.value() != *hi || min.value() != *lo || sum.size() != i + 1 - first;
+    sum_error = std::max(sum_error, std::abs(static_cast<double>(sum.sum()) - s));
+    square_error = std::max(square_error,
+                            std::abs(static_cast<double>(sum.sum_square()) - s2) /
+                            std::max(s2, 1.));
+  }
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s min/max", name);
+  check(label, wrong == 0);
+  std::snprintf(label, sizeof(label), "%s sum", name);
+  check(label, sum_error, 0, 1e-9);
+  std::snprintf(label, sizeof(label), "%s sum square", name);
+  check(label, square_error, 0, 1e-12);
+}
+
+static void
+sliding() {
+  harness::signal const sig{.offset = 0, .amplitude = 3};
+  auto const data = sig.make<double>(2048);
+  wave::sliding_stats<1280, double> stats;
+  stats.push(data.begin(), data.end());
+  check("sliding max", stats.max(), 3, 1e-3);
+  check("sliding min", stats.min(), -3, 1e-3);
+  check("sliding crest factor", stats.crest_factor(), std::sqrt(2), 1e-3);
+
+  // Non periodic: random walk plus noise, and integers with many ties
+  std::mt19937 gen(11);
+  std::normal_distribution<double> step(0, 1);
+  std::vector<double> walk(20000);
+  double x = 0;
+  for (auto& v : walk)
+    v = (x += step(gen)) + step(gen);
+  std::uniform_int_distribution<int> level(-8, 8);
+  std::vector<int> levels(20000);
+  for (auto& v : levels)
+    v = level(gen);
+
+  sliding_brute<1>("sliding N=1", walk);
+  sliding_brute<7>("sliding N=7", walk);
+  sliding_brute<256>("sliding N=256", walk);
+  sliding_brute<4096>("sliding N=size", std::vector<double>(walk.begin(),
+                                                           walk.begin() + 4096));
+  sliding_brute<1>("sliding int N=1", levels);
+  sliding_brute<33>("sliding int N=33", levels);
+
+  // Resync: the add/subtract of 1e12 leaves ~1e-4 of error, only the
+  // recomputation at the end of the ring clears it
+  constexpr const std::size_t n = 64;
+  std::uniform_real_distribution<double> small(0, 1);
+  wave::sliding_sum<n, double> sum;
+  for (std::size_t i = 0; i < n; ++i)
+    sum.push(1e12 + small(gen));
+  double expected = 0, expected_square = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    double const v = small(gen);
+    sum.push(v);
+    expected += v;
+    expected_square += v * v;
+  }
+  check("sliding sum resync", sum.sum(), expected, 1e-12);
+  check("sliding sum square resync", sum.sum_square(), expected_square, 1e-12);
+}
+
+static void
+cycles() {
+  harness::signal const sig{.offset = 0, .amplitude = 1, .frequency = 59.93,
+                            .sample_freq = 2000, .noise = 0.01};
+  auto const data = sig.make<double>(20000);
+  wave::zero_crossing<double> zc(sig.sample_freq, 0.1);
+  zc.process(data.begin(), data.end(), [](const wave::cycle&) {});
+  check("zero_crossing frequency", zc.sample_freq() / zc.stats().mean,
+        sig.frequency, 1e-3);
+
+  std::size_t count = 0;
+  wave::for_each_cycle(data.begin(), data.begin() + 2000,
+                       [&](auto, auto) { ++count; }, 0.0, 0.1);
+  check("for_each_cycle count", count, 58, 1);
+}
+
+static void
+spectrum() {
+  harness::signal const sig{.harmonics = {0, 0.2, 0, 0.1}};
+  auto const data = sig.make<double>(1024);
+  double const thd = std::hypot(0.2, 0.1);
+
+  wave::harmonic_analyzer<5, float> analyzer(sig.frequency, sig.sample_freq);
+  auto const r = analyzer(data.begin(), data.end());
+  check("harmonic_analyzer fundamental", r.amplitude[0], sig.amplitude, 1);
+  check("harmonic_analyzer thd", r.thd, thd, 1e-3);
+
+  wave::real_fft<1024, float> fft;
+  wave::real_fft<1024, float>::output_type out;
+  fft.transform(data.begin(), out, static_cast<float>(sig.offset));
+  auto const h = wave::harmonics<5>(out, 8);
+  check("real_fft fundamental", h.amplitude[0], sig.amplitude, 1);
+  check("real_fft thd", h.thd, thd, 1e-3);
+}
+
+struct record {
+  std::uint32_t ch;
+  std::uint32_t v;
+
+  std::uint32_t channel() const noexcept { return ch; }
+  std::uint32_t value() const noexcept { return v; }
+};
+
+static void
+channels() {
+  harness::signal const voltage{.amplitude = 1500};
+  harness::signal const current{.amplitude = 800, .phase = -0.5};
+  auto const v = voltage.make<std::uint32_t>(7680);
+  auto const i = current.make<std::uint32_t>(7680);
+  std::vector<record> frame;
+  for (std::size_t n = 0; n < v.size(); ++n) {
+    frame.push_back({0, v[n]});
+    frame.push_back({3, i[n]});
+  }
+
+  auto [begin, end] = wave::channel_range(frame.data(), frame.data() + frame.size(), 3);
+  check("channel_range mean", wave::mean(begin, end), current.offset, 0.5);
+
+  using meter = wave::power_meter<unity_sensor, unity_sensor>;
+  meter pm({.voltage_channel = 0, .current_channel = 3,
+            .sample_freq = voltage.sample_freq, .skew = 0,
+            .window = 1280});
+  wave::power_result<double> result;
+  double energy = 0;
+  std::size_t windows = 0;
+  pm.process(frame.begin(), frame.end(), [&](const auto& r) {
+    result = r;
+    energy += r.active * r.samples / voltage.sample_freq;
+    ++windows;
+  });
+  check("power_meter power factor", result.power_factor, std::cos(0.5), 1e-3);
+  // First pair pushed at the second voltage sample: 7679 pairs, 5 windows
+  double const active = voltage.rms() * current.rms() * std::cos(0.5);
+  check("power_meter windows", windows == 5);
+  check("power_meter energy", pm.energy(), energy, 1e-9 * energy);
+  check("power_meter energy (expected)", pm.energy(),
+        active * 5 * 1280 / voltage.sample_freq, 1e-3 * energy);
+}
+
+/**
+ * Current sampled half a sample after the voltage, in phase with it
+ */
+static void
+power_skew() {
+  harness::signal const voltage{.amplitude = 1500};
+  harness::signal const current{.amplitude = 800,
+                                .phase = M_PI * voltage.frequency / voltage.sample_freq};
+  auto const v = voltage.make<std::uint32_t>(7680);
+  auto const i = current.make<std::uint32_t>(7680);
+  std::vector<record> frame;
+  for (std::size_t n = 0; n < v.size(); ++n) {
+    frame.push_back({0, v[n]});
+    frame.push_back({1, i[n]});
+  }
+
+  using meter = wave::power_meter<unity_sensor, unity_sensor>;
+  auto power_factor = [&](double skew) {
+    meter pm({.voltage_channel = 0, .current_channel = 1,
+              .sample_freq = voltage.sample_freq, .skew = skew,
+              .window = 1280});
+    double pf = 0;
+    pm.process(frame.begin(), frame.end(), [&](const auto& r) { pf = r.power_factor; });
+    return pf;
+  };
+  check("power_meter skew", meter::skew(0, 1, 2) == 0.5);
+  check("power_meter skew corrected", power_factor(meter::skew(0, 1, 2)), 1, 1e-5);
+  check("power_meter skew not corrected", power_factor(0) < 1 - 1e-4);
+}
+
+/**
+ * Cycle windows closed by the 'window' limit while the voltage is missing:
+ * the next window must be aligned again to measure the frequency
+ */
+static void
+power_cap() {
+  harness::signal const sine{.offset = 0};
+  auto const on = sine.make<double>(1280);
+  std::vector<double> voltage(on.begin(), on.end());
+  voltage.insert(voltage.end(), 1500, -10.);    // Missing, inside the hysteresis
+  voltage.insert(voltage.end(), on.begin(), on.end());
+
+  using meter = wave::power_meter<unity_sensor, unity_sensor>;
+  meter pm({.voltage_channel = 0, .current_channel = 1,
+            .sample_freq = sine.sample_freq,
+            .window = 1000, .cycles = 2, .hysteresis = 50});
+  std::size_t windows = 0, capped = 0, wrong = 0, partial = 0;
+  double energy = 0;
+  for (double x : voltage)
+    pm.push(x, x, [&](const auto& r) {
+      ++windows;
+      capped += r.samples == 1000;
+      energy += r.active * r.samples / sine.sample_freq;
+      if (r.frequency == 0)
+        return;
+      wrong += std::abs(r.frequency - sine.frequency) > 0.5;
+      // Whole cycles only: 2 cycles of 128 samples, RMS of the sine
+      partial += r.samples < 254 || r.samples > 258 ||
+                 std::abs(r.voltage_rms - sine.rms()) > 5e-3 * sine.rms();
+    });
+  check("power_meter cap windows", windows == 9 && capped == 1);
+  check("power_meter cap frequency", wrong == 0);
+  check("power_meter cap whole cycles", partial == 0);
+  // Samples discarded to realign still count as energy
+  check("power_meter cap energy", pm.energy() > energy);
+}
+
+int main() {
+  core();
+  accumulators();
+  filters();
+  decimator();
+  sliding();
+  cycles();
+  spectrum();
+  channels();
+  power_skew();
+  power_cap();
+  return harness::result();
+}
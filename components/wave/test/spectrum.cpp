@@ -0,0 +1,107 @@
+/**
+ * @file spectrum.cpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Accuracy of wave spectrum on synthetic waveforms, and time/memory
+ *        per 1024-point frame
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+#include "wave/spectrum.hpp"
+
+#include "harness.hpp"
+
+using harness::check;
+
+static constexpr const std::size_t size = 1024;
+static constexpr const double sample_freq = 7680;   // 128 samples per 60 Hz cycle
+
+static std::vector<std::uint32_t>
+make_signal(double fundamental, std::size_t samples = size) {
+  std::vector<std::uint32_t> signal(samples);
+  for (std::size_t i = 0; i < samples; ++i) {
+    double const t = i / sample_freq;
+    double const v = 2048 + 1000 * std::sin(2 * M_PI * fundamental * t)
+                          + 200 * std::sin(2 * M_PI * 3 * fundamental * t + 0.5)
+                          + 100 * std::sin(2 * M_PI * 5 * fundamental * t + 1.0)
+                          + 30 * std::sin(2 * M_PI * 15 * fundamental * t);
+    signal[i] = static_cast<std::uint32_t>(std::lround(v));
+  }
+  return signal;
+}
+
+template<typename Func>
+static double
+us_per_frame(Func&& func) {
+  return harness::ns_per_sample(1, std::forward<Func>(func)) / 1000;
+}
+
+int main() {
+  double const expected_thd = std::sqrt(0.2 * 0.2 + 0.1 * 0.1 + 0.03 * 0.03);
+
+  // FFT against a direct DFT
+  auto signal = make_signal(60);
+  wave::real_fft<size> fft;
+  wave::real_fft<size>::output_type spectrum;
+  fft.transform(signal.begin(), spectrum);
+
+  double max_error = 0;
+  for (std::size_t k = 0; k <= size / 2; ++k) {
+    std::complex<double> dft = 0;
+    for (std::size_t n = 0; n < size; ++n)
+      dft += static_cast<double>(signal[n]) *
+             std::polar(1.0, -2 * M_PI * k * n / size);
+    max_error = std::max(max_error,
+                         std::abs(dft - std::complex<double>(spectrum[k])) / size);
+  }
+  check("fft vs dft (max error / N)", max_error, 0, 1e-3);
+
+  auto fft_result = wave::harmonics<15>(spectrum, 8);
+  check("fft fundamental", fft_result.amplitude[0], 1000, 0.1);
+  check("fft 3rd harmonic", fft_result.amplitude[2], 200, 0.1);
+  check("fft 5th harmonic", fft_result.amplitude[4], 100, 0.1);
+  check("fft 15th harmonic", fft_result.amplitude[14], 30, 0.1);
+  check("fft thd", fft_result.thd, expected_thd, 1e-4);
+
+  // Goertzel (1024 samples = 8 cycles)
+  wave::harmonic_analyzer<15> analyzer(60, sample_freq);
+  auto g_result = analyzer(signal.begin(), signal.end());
+  check("goertzel fundamental", g_result.amplitude[0], 1000, 0.1);
+  check("goertzel 3rd harmonic", g_result.amplitude[2], 200, 0.1);
+  check("goertzel thd", g_result.thd, expected_thd, 1e-4);
+
+  std::size_t const cycles_size =
+      static_cast<std::size_t>(std::lround(7 * sample_freq / 50.3));  // 7 cycles
+  auto off_signal = make_signal(50.3, cycles_size);
+  wave::harmonic_analyzer<15> off_analyzer(50.3, sample_freq);
+  // Fundamental off the FFT bins
+  auto off_result = off_analyzer(off_signal.begin(), off_signal.end());
+  check("goertzel 50.3Hz fundamental", off_result.amplitude[0], 1000, 1);
+  check("goertzel 50.3Hz thd", off_result.thd, expected_thd, 5e-4);
+
+  // Time and memory
+  double fft_us = us_per_frame([&] {
+    fft.transform(signal.begin(), spectrum);
+    harness::keep(spectrum);
+  });
+  double goertzel_us = us_per_frame([&] {
+    g_result = analyzer(signal.begin(), signal.end());
+    harness::keep(g_result);
+  });
+  std::printf("real_fft<1024, float>: %zu bytes + %zu bytes output, "
+              "%.2f us/frame\n",
+              sizeof(fft), sizeof(spectrum), fft_us);
+  std::printf("harmonic_analyzer<15, float>: %zu bytes, %.2f us/frame\n",
+              sizeof(analyzer), goertzel_us);
+
+  return harness::result();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file log_sink.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief lg sink that streams the records to the subscribed websocket
+ *        clients of a publisher
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * using log_publisher = websocket::publisher<8, CONFIG_LG_BUFFER_SIZE>;
+ * using ws_sink = websocket::log_sink<log_publisher>;
+ * using remote = lg::config<true, false, lg::timestamp, false,
+ *                           lg::tee_sink<lg::stdout_sink, ws_sink>>;
+ *
+ * static log_publisher logs(server.native());
+ * ws_sink::attach(logs);
+ *
+ * // At the websocket on_open/on_data handler
+ * logs.subscribe(websocket::client(req));
+ *
+ * lg::info<remote>("ADC", "{} samples", size);
+ */
+#ifndef COMPONENTS_WEBSOCKET_LOG_SINK_HPP_
+#define COMPONENTS_WEBSOCKET_LOG_SINK_HPP_
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+
+#include <cstdint>
+#include <cstddef>
+
+#include <atomic>
+#include <span>
+
+#include "esp_http_server.h"
+
+#include "lg/core.hpp"
+
+#include "websocket/publisher.hpp"
+
+namespace websocket {
+
+/**
+ * Each record is one message, copied to a publisher slot and sent by the
+ * http server task: the caller never waits for the network. A record is
+ * dropped (counted at stats()) if all slots are still being sent; the
+ * publisher keeps the drops per client.
+ *
+ * Without a attached publisher or subscribed clients nothing is written
+ * or dropped. Binary messages with CONFIG_LG_STRIP_FORMAT (lg/strip.hpp),
+ * else text.
+ */
+template<typename Publisher,
+#ifdef CONFIG_LG_STRIP_FORMAT
+         httpd_ws_type_t Type = HTTPD_WS_TYPE_BINARY>
+#else
+         httpd_ws_type_t Type = HTTPD_WS_TYPE_TEXT>
+#endif
+class log_sink {
+ public:
+  static_assert(Publisher::slot_size >= CONFIG_LG_BUFFER_SIZE,
+                "Publisher slot smaller than a lg record");
+
+  /**
+   * 'pub' must outlive the logging (e.g. static)
+   */
+  static void
+  attach(Publisher& pub) noexcept {
+    pub_.store(&pub, std::memory_order_release);
+  }
+
+  static void
+  detach() noexcept {
+    pub_.store(nullptr, std::memory_order_release);
+  }
+
+  static bool
+  write(const char* data, std::size_t size) noexcept {
+    auto* pub = pub_.load(std::memory_order_acquire);
+    if (!pub || pub->subscribers() == 0)
+      return true;
+    return counters_.count(pub->publish(
+              std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(data),
+                                            size),
+              Type));
+  }
+
+  [[nodiscard]] static lg::sink_statistics
+  stats() noexcept {
+    return counters_.stats();
+  }
+
+ private:
+  static inline std::atomic<Publisher*> pub_{nullptr};
+  static inline lg::sink_counters       counters_;
+};
+
+}  // namespace websocket
+
+#endif  // CONFIG_HTTPD_WS_SUPPORT
+
+#endif  // COMPONENTS_WEBSOCKET_LOG_SINK_HPP_
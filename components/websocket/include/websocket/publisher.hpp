@@ -0,0 +1,300 @@
+/**
+ * @file publisher.hpp
+ * @author Rafael Cunha (rnascunha@gmail.com)
+ * @brief Streams binary messages to subscribed websocket clients, without
+ *        blocking the producer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * static websocket::publisher<4, 1024> scope(server.native());
+ *
+ * // At the websocket on_open/on_data handler
+ * scope.subscribe(websocket::client(req));
+ *
+ * // Acquisition/processing task
+ * scope.publish([&](std::span<std::uint8_t> buffer) {
+ *   return uc::adc::pack(uc::adc::encoding::packed12, seq++, ADC_CHANNEL_0,
+ *                        samples.begin(), samples.end(), buffer);
+ * });
+ */
+#ifndef COMPONENTS_WEBSOCKET_PUBLISHER_HPP_
+#define COMPONENTS_WEBSOCKET_PUBLISHER_HPP_
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <span>
+
+#include "esp_http_server.h"
+
+#include "sys/error.hpp"
+
+#include "websocket/server.hpp"
+
+namespace websocket {
+
+/**
+ * The message is written (publish()) at one of 'Slots' preallocated
+ * buffers of 'SlotSize' bytes, and the send is queued to the http server
+ * task (httpd_queue_work), so the producer never waits for the network.
+ * Nothing is allocated after construction.
+ *
+ * Backpressure:
+ * - if all slots are still being sent, the new message is dropped
+ *   (statistics::dropped);
+ * - a client whose send fails skips the next 2^failures - 1 messages
+ *   (counted at its 'dropped'), so one slow client doesn't hold the
+ *   server task sending to it at every message. After 'MaxFailures'
+ *   consecutive failures its session is closed and it is unsubscribed.
+ *
+ * Clients not connected as websocket anymore are unsubscribed at the next
+ * send. The publisher must outlive the queued sends (e.g. static).
+ */
+template<std::size_t Slots,
+         std::size_t SlotSize,
+         std::size_t MaxClients = 4,
+         unsigned MaxFailures = 6>
+class publisher {
+ public:
+  static_assert(Slots > 0 && SlotSize > 0 && MaxClients > 0);
+  static_assert(MaxFailures > 0 && MaxFailures < 16);
+
+  using buffer_type = std::span<std::uint8_t, SlotSize>;
+  static constexpr const std::size_t slot_size = SlotSize;
+
+  struct statistics {
+    std::uint32_t published;        // Queued to send
+    std::uint32_t dropped;          // No free slot, or queue failed
+    std::uint32_t client_dropped;   // Skipped or failed, all clients
+    std::uint32_t removed;          // Clients unsubscribed by failures
+  };
+
+  struct client_statistics {
+    int           fd;               // -1: free
+    std::uint32_t sent;
+    std::uint32_t dropped;
+  };
+
+  publisher(httpd_handle_t hd) noexcept
+   : hd_(hd) {
+    for (auto& s : slots_)
+      s.owner = this;
+  }
+  publisher(const publisher&) = delete;
+  publisher& operator=(const publisher&) = delete;
+
+  bool subscribe(const client& cl) noexcept {
+    return subscribe(cl.fd);
+  }
+
+  bool subscribe(int fd) noexcept {
+    for (auto& c : clients_)
+      if (c.fd.load(std::memory_order_acquire) == fd)
+        return true;
+    for (auto& c : clients_) {
+      int expected = -1;
+      if (c.fd.compare_exchange_strong(expected, fd, std::memory_order_acq_rel)) {
+        c.sent.store(0, std::memory_order_relaxed);
+        c.dropped.store(0, std::memory_order_relaxed);
+        c.failures.store(0, std::memory_order_relaxed);
+        c.skip.store(0, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void unsubscribe(const client& cl) noexcept {
+    unsubscribe(cl.fd);
+  }
+
+  void unsubscribe(int fd) noexcept {
+    for (auto& c : clients_) {
+      int expected = fd;
+      c.fd.compare_exchange_strong(expected, -1, std::memory_order_acq_rel);
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  subscribers() const noexcept {
+    return std::count_if(clients_.begin(), clients_.end(), [](const auto& c) {
+      return c.fd.load(std::memory_order_relaxed) >= 0;
+    });
+  }
+
+  /**
+   * 'fill' writes the message at the buffer and returns its size (0:
+   * nothing to send). Returns false if the message was not queued.
+   */
+  template<typename Fill>
+  bool publish(Fill&& fill, httpd_ws_type_t type = HTTPD_WS_TYPE_BINARY) noexcept {
+    if (subscribers() == 0)
+      return false;
+
+    slot* s = take();
+    if (!s) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    std::size_t const size = fill(buffer_type(s->buffer, SlotSize));
+    if (size == 0 || size > SlotSize) {
+      give(s);
+      return false;
+    }
+    s->size = size;
+    s->type = type;
+
+    if (httpd_queue_work(hd_, send_work, s) != ESP_OK) {
+      give(s);
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool publish(std::span<const std::uint8_t> message,
+               httpd_ws_type_t type = HTTPD_WS_TYPE_BINARY) noexcept {
+    return publish([message](buffer_type buffer) -> std::size_t {
+      if (message.size() > buffer.size())
+        return 0;
+      std::memcpy(buffer.data(), message.data(), message.size());
+      return message.size();
+    }, type);
+  }
+
+  [[nodiscard]] statistics
+  stats() const noexcept {
+    return {
+      published_.load(std::memory_order_relaxed),
+      dropped_.load(std::memory_order_relaxed),
+      client_dropped_.load(std::memory_order_relaxed),
+      removed_.load(std::memory_order_relaxed)
+    };
+  }
+
+  [[nodiscard]] client_statistics
+  stats(std::size_t index) const noexcept {
+    auto const& c = clients_[index];
+    return {
+      c.fd.load(std::memory_order_relaxed),
+      c.sent.load(std::memory_order_relaxed),
+      c.dropped.load(std::memory_order_relaxed)
+    };
+  }
+
+  [[nodiscard]] static constexpr std::size_t
+  max_clients() noexcept {
+    return MaxClients;
+  }
+
+ private:
+  struct slot {
+    std::atomic<bool> busy{false};
+    std::size_t       size = 0;
+    httpd_ws_type_t   type = HTTPD_WS_TYPE_BINARY;
+    publisher*        owner = nullptr;
+    alignas(4) std::uint8_t buffer[SlotSize];
+  };
+
+  struct subscriber {
+    std::atomic<int>            fd{-1};
+    std::atomic<std::uint32_t>  sent{0};
+    std::atomic<std::uint32_t>  dropped{0};
+    std::atomic<unsigned>       failures{0};
+    std::atomic<std::uint32_t>  skip{0};
+  };
+
+  slot* take() noexcept {
+    for (auto& s : slots_) {
+      bool expected = false;
+      if (s.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        return &s;
+    }
+    return nullptr;
+  }
+
+  static void give(slot* s) noexcept {
+    s->busy.store(false, std::memory_order_release);
+  }
+
+  /**
+   * Runs at the http server task
+   */
+  static void send_work(void* arg) noexcept {
+    auto* s = static_cast<slot*>(arg);
+    auto* self = s->owner;
+    frame frm{};
+    frm.payload = s->buffer;
+    frm.len = s->size;
+    frm.type = s->type;
+
+    for (auto& c : self->clients_) {
+      int const fd = c.fd.load(std::memory_order_acquire);
+      if (fd < 0)
+        continue;
+      if (auto const skip = c.skip.load(std::memory_order_relaxed)) {
+        c.skip.store(skip - 1, std::memory_order_relaxed);
+        self->drop(c);
+        continue;
+      }
+      if (httpd_ws_get_fd_info(self->hd_, fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+        self->remove(c, fd, false);
+        continue;
+      }
+      if (client(self->hd_, fd).send(frm)) {
+        self->drop(c);
+        unsigned const failures = c.failures.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (failures >= MaxFailures)
+          self->remove(c, fd, true);
+        else
+          c.skip.store((1u << failures) - 1, std::memory_order_relaxed);
+        continue;
+      }
+      c.failures.store(0, std::memory_order_relaxed);
+      c.sent.fetch_add(1, std::memory_order_relaxed);
+    }
+    give(s);
+  }
+
+  void drop(subscriber& c) noexcept {
+    c.dropped.fetch_add(1, std::memory_order_relaxed);
+    client_dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void remove(subscriber& c, int fd, bool close) noexcept {
+    int expected = fd;
+    if (c.fd.compare_exchange_strong(expected, -1, std::memory_order_acq_rel)) {
+      removed_.fetch_add(1, std::memory_order_relaxed);
+      if (close)
+        httpd_sess_trigger_close(hd_, fd);
+    }
+  }
+
+  httpd_handle_t                  hd_;
+  std::array<slot, Slots>         slots_{};
+  std::array<subscriber, MaxClients>
+                                  clients_{};
+
+  std::atomic<std::uint32_t>      published_{0};
+  std::atomic<std::uint32_t>      dropped_{0};
+  std::atomic<std::uint32_t>      client_dropped_{0};
+  std::atomic<std::uint32_t>      removed_{0};
+};
+
+}  // namespace websocket
+
+#endif  // CONFIG_HTTPD_WS_SUPPORT
+
+#endif  // COMPONENTS_WEBSOCKET_PUBLISHER_HPP_
@@ -30,11 +30,7 @@
 #define EXAMPLE_ADC_ATTEN                   ADC_ATTEN_DB_12
 #define EXAMPLE_ADC_BIT_WIDTH               SOC_ADC_DIGI_MAX_BITWIDTH
 
-#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
-#define EXAMPLE_ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
-#else
-#define EXAMPLE_ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE2
-#endif
+#define EXAMPLE_ADC_OUTPUT_TYPE             uc::adc::stream::data::output_format
 
 #define EXAMPLE_ADC_BUFFER_SIZE             4092
 #define EXAMPLE_READ_LEN_BYTES              1400
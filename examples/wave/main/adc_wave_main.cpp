@@ -11,51 +11,42 @@
 #include <cstring>
 #include <chrono>
 #include <algorithm>
+#include <iterator>
 
 #include "lg/log.hpp"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/semphr.h"
+
+#include "esp_cpu.h"
 
 #include "sys/error.hpp"
 #include "sys/sys.hpp"
 #include "sys/time.hpp"
 
-#include "uc/adc/stream.hpp"
+#include "uc.hpp"
+#include "uc/adc/basic_stream.hpp"
+#include "uc/adc/acquisition.hpp"
 #include "wave.hpp"
+#include "wave/channel.hpp"
 
 #define EXAMPLE_ADC_UNIT                    ADC_UNIT_1
-#define _EXAMPLE_ADC_UNIT_STR(unit)         #unit
-#define EXAMPLE_ADC_UNIT_STR(unit)          _EXAMPLE_ADC_UNIT_STR(unit)
-#define EXAMPLE_ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
-#define EXAMPLE_ADC_ATTEN                   ADC_ATTEN_DB_12
-#define EXAMPLE_ADC_BIT_WIDTH               SOC_ADC_DIGI_MAX_BITWIDTH
-
-#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
-#define EXAMPLE_ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
-#else
-#define EXAMPLE_ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE2
-#endif
+#define EXAMPLE_ADC_CHANNEL                 ADC_CHANNEL_0
+
+using adc_channel = uc::adc::channel<EXAMPLE_ADC_UNIT, EXAMPLE_ADC_CHANNEL>;
+using adc_stream = uc::adc::basic_stream<uc::compiled_mcu, adc_channel>;
+using adc_data = adc_stream::data;
+using adc_acquisition = uc::adc::acquisition<uc::adc::stream>;
 
 #define EXAMPLE_ADC_BUFFER_SIZE             4092
 #define EXAMPLE_READ_LEN_BYTES              1400
-#define EXAMPLE_READ_LEN                    (EXAMPLE_READ_LEN_BYTES / sizeof(uc::adc::stream::data))
+#define EXAMPLE_SAMPLE_FREQ                 (26 * 1000)
+#define EXAMPLE_BUFFER_SAMPLES              (EXAMPLE_SAMPLE_FREQ / 10)   // 100 ms
 
 static constexpr const
 lg::log ll{"wave"};
 
-static bool IRAM_ATTR
-conversion_done(adc_continuous_handle_t handle,
-               const adc_continuous_evt_data_t *edata,
-               void *user_data) {
-  BaseType_t mustYield = pdFALSE;
-  vTaskNotifyGiveFromISR((TaskHandle_t)user_data, &mustYield);
-
-  return (mustYield == pdTRUE);
-}
-
-bool validate_data(uc::adc::stream::data* begin,
+bool validate_data(const adc_data* begin,
                    std::size_t size) noexcept {
   auto end = begin + size;
   while (begin != end) {
@@ -66,31 +57,46 @@ bool validate_data(uc::adc::stream::data* begin,
   return true;
 }
 
-// Need to incresase size of task to put array inside
-static
-double bbout[EXAMPLE_READ_LEN]{};
+struct rms_result {
+  double        rms;
+  std::uint32_t cycles;
+  std::size_t   samples;
+};
 
-double process_adc_data(uc::adc::stream::data* data,
-                        std::size_t size) noexcept {
-  using value_type = uc::adc::stream::data::value_type;
-  value_type* begin = &data->raw_data().val;
-  value_type* end = begin;
-  for (std::size_t i = 0; i < size; ++i)
-    *end++ = data[i].value();
-
-  double* bout = bbout;
-  double* eout = bout + size;
-
-  wave::filter_first_order(begin, end, 0.8);
-  wave::convert(begin, end, bout);
-  wave::remove_constant(bout, eout,
-                          wave::mean(bout, eout));
+/**
+ * Runs directly over the ADC records: no copy of the samples and no
+ * intermediate value array.
+ */
+rms_result process_adc_data(const adc_data* data,
+                            std::size_t size) noexcept {
+  auto [begin, end] = wave::channel_range(data, data + size,
+                                          adc_channel::number & 0x7);
+  rms_result result{};
+
+  auto start = esp_cpu_get_cycle_count();
+  result.rms = wave::rms_sine_fused(begin, end, 0.8);
+  result.cycles = esp_cpu_get_cycle_count() - start;
+  result.samples = std::distance(begin, end);
+
+  return result;
+}
 
-  return wave::rms_sine(bout, eout);
+/**
+ * Called by the acquisition processing task for every full buffer
+ */
+void on_buffer(adc_acquisition::span_type buffer, void*) noexcept {
+  if (!validate_data(buffer.data(), buffer.size())) {
+    ll.warn("Invalid data received");
+    return;
+  }
+  auto rms = process_adc_data(buffer.data(), buffer.size());
+  if (rms.samples != 0)
+    ll.info("Irms = {} [{} cycles/sample]",
+             rms.rms, rms.cycles / rms.samples);
 }
 
 extern "C" void app_main() {
-  uc::adc::stream adc({
+  static adc_stream adc({
     .max_store_buf_size = EXAMPLE_ADC_BUFFER_SIZE,
     .conv_frame_size = EXAMPLE_READ_LEN_BYTES,
     .flags = {
@@ -103,53 +109,28 @@ extern "C" void app_main() {
     return;
   }
 
-  uc::adc::stream::pattern ptt[]{
-    {
-      .atten      = EXAMPLE_ADC_ATTEN,
-      .channel    = ADC_CHANNEL_0 & 0x7,
-      .unit       = EXAMPLE_ADC_UNIT,
-      .bit_width  = EXAMPLE_ADC_BIT_WIDTH
-    }
-  };
-
-  adc.configure({
-    .pattern_num    = sizeof(ptt) / sizeof(ptt[0]),
-    .adc_pattern    = ptt,
-    .sample_freq_hz = 26 * 1000,
-    .conv_mode      = EXAMPLE_ADC_CONV_MODE,
-    .format         = EXAMPLE_ADC_OUTPUT_TYPE,
-  });
+  adc.configure(EXAMPLE_SAMPLE_FREQ);
 
-  adc.register_handler({
-    .on_conv_done = conversion_done,
-    .on_pool_ovf = nullptr
-  }, xTaskGetCurrentTaskHandle());
-  
-  if (adc.start()) {
-    ll.error("Error starting ADC continuous");
+  // Reader on core 1, processing on core 0
+  static adc_acquisition acq(adc.native(), {
+    .buffer_samples = EXAMPLE_BUFFER_SAMPLES,
+    .reader_core = 1,
+    .process_core = 0
+  }, on_buffer);
+
+  if (acq.start()) {
+    ll.error("Error starting ADC acquisition");
     return;
   }
 
-  uc::adc::stream::data data[EXAMPLE_READ_LEN]{};
-
-  while(1) {
-    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-    while (1) {
-      auto result = adc.read(data, EXAMPLE_READ_LEN, 0);
-      if (result) {
-        ll.info("{} new samples collected", result.readed);
-        if (!validate_data(data, result.readed)) {
-          ll.warn("Invalid data received");
-        } else {
-          ll.info("Irms = {}",
-                   process_adc_data(data, result.readed));
-        }
-        using namespace std::chrono_literals;
-        sys::delay(1s); // Need for watchdog
-      } else if (result.error == ESP_ERR_TIMEOUT) {
-        break;
-      }
-    }
+  while (true) {
+    using namespace std::chrono_literals;
+    sys::delay(10s);
+    auto st = acq.stats();
+    auto ad = adc.native().stats();
+    ll.info("buffers {} dropped {} pool overflows {} | frames {} "
+            "interval {}-{} us latency max {} us",
+             st.buffers, st.dropped_buffers, st.pool_overflows,
+             ad.frames, ad.min_interval, ad.max_interval, ad.max_latency);
   }
 }
@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+#########################################################################
+# Decodes the binary lg records of a firmware built with                #
+# CONFIG_LG_STRIP_FORMAT (see components/lg/include/lg/strip.hpp).      #
+# The format strings are read from the '.lg_fmt' section of the ELF     #
+# file. Anything that is not a record (boot messages, text logs) is     #
+# copied as is.                                                         #
+#                                                                       #
+# Only python standard library is used.                                 #
+#########################################################################
+#
+# $ python scripts/lg_decode.py build/app.elf capture.bin
+# $ stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 | python scripts/lg_decode.py build/app.elf
+# $ python scripts/lg_decode.py --list build/app.elf
+
+import argparse
+import string
+import struct
+import sys
+
+FRAME = 0x1E
+ENTRY = 0x01
+SECTION = '.lg_fmt'
+
+COLORS = {
+    'E': '\033[0;31m',
+    'W': '\033[0;33m',
+    'I': '\033[0;32m',
+}
+RESET = '\033[0m'
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def elf_section(path, name):
+    """Contents of the section 'name' of a little endian ELF32/ELF64 file"""
+    with open(path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[5] != 1:
+        raise ValueError(f'{path}: not a little endian ELF file')
+    if elf[4] == 1:
+        shoff, = struct.unpack_from('<I', elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+        header = '<IIIIIIIIII'
+    else:
+        shoff, = struct.unpack_from('<Q', elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x3A)
+        header = '<IIQQQQIIQQ'
+
+    sections = [struct.unpack_from(header, elf, shoff + i * shentsize)
+                for i in range(shnum)]
+    names = sections[shstrndx]
+    for sh in sections:
+        start = names[4] + sh[0]
+        sh_name = elf[start:elf.index(b'\0', start)].decode()
+        if sh_name == name:
+            return elf[sh[4]:sh[4] + sh[5]]
+    return None
+
+
+def read_formats(path):
+    """{id: (signature, format)} of all '.lg_fmt' entries"""
+    section = elf_section(path, SECTION)
+    if section is None:
+        raise ValueError(f'{path}: no {SECTION} section '
+                         '(built without CONFIG_LG_STRIP_FORMAT?)')
+    formats = {}
+    i = 0
+    while True:
+        i = section.find(bytes([ENTRY]), i)
+        if i < 0:
+            break
+        sig_end = section.index(b'\0', i + 1)
+        fmt_end = section.index(b'\0', sig_end + 1)
+        key = section[i + 1:fmt_end]
+        entry = (section[i + 1:sig_end].decode(),
+                 section[sig_end + 1:fmt_end].decode('utf-8', 'replace'))
+        id = fnv1a(key)
+        if formats.get(id, entry) != entry:
+            print(f'warning: id {id:08x} collision: {formats[id]} / {entry}',
+                  file=sys.stderr)
+        formats[id] = entry
+        i = fmt_end + 1
+    return formats
+
+
+class Bool:
+    def __init__(self, value):
+        self.value = value
+
+    def __format__(self, spec):
+        if spec and spec[-1] in 'bBdoxX':
+            return format(int(self.value), spec)
+        return format('true' if self.value else 'false', spec)
+
+
+class Char:
+    def __init__(self, value):
+        self.value = value
+
+    def __format__(self, spec):
+        if spec and spec[-1] in 'bBdoxX':
+            return format(ord(self.value), spec)
+        return format(self.value, spec)
+
+
+class Float:
+    """Shortest representation (as fmt) of float (32 bits) and double"""
+
+    def __init__(self, value, single):
+        self.value = value
+        self.single = single
+
+    def shortest(self):
+        text = repr(self.value)
+        if self.single:
+            for precision in range(1, 10):
+                short = float(f'{self.value:.{precision}g}')
+                if struct.unpack('<f', struct.pack('<f', short))[0] == self.value:
+                    text = repr(short)
+                    break
+        return text[:-2] if text.endswith('.0') else text
+
+    def __format__(self, spec):
+        if spec and (spec[-1] in 'aAeEfFgG%' or '.' in spec):
+            return format(self.value, spec)
+        try:
+            return format(self.shortest(), spec)
+        except ValueError:
+            return format(self.value, spec)
+
+
+def read_args(signature, data, offset):
+    args = []
+    for code in signature:
+        if code == 's':
+            size = data[offset]
+            args.append(data[offset + 1:offset + 1 + size].decode('utf-8', 'replace'))
+            offset += 1 + size
+        elif code == 'c':
+            args.append(Char(chr(data[offset])))
+            offset += 1
+        else:
+            value, = struct.unpack_from('<' + code, data, offset)
+            offset += struct.calcsize(code)
+            if code == '?':
+                value = Bool(value)
+            elif code in 'fd':
+                value = Float(value, code == 'f')
+            args.append(value)
+    return args, offset
+
+
+def format_message(fmt, args):
+    # fmt syntax is python format syntax for the supported types
+    return string.Formatter().vformat(fmt, args, {})
+
+
+def decode_record(formats, record, color):
+    """'record' is the data after the size field. None if not valid."""
+    if len(record) < 10:
+        return None
+    id, time = struct.unpack_from('<II', record, 0)
+    if id not in formats:
+        return None
+    signature, fmt = formats[id]
+    level = chr(record[8])
+    tag_size = record[9]
+    tag = record[10:10 + tag_size].decode('utf-8', 'replace')
+    try:
+        args, used = read_args(signature, record, 10 + tag_size)
+        if used != len(record):
+            return None
+        message = format_message(fmt, args)
+    except (IndexError, struct.error, ValueError, KeyError):
+        return None
+    line = f'{level} ({time}) {tag}:{message}'
+    if color:
+        line = COLORS.get(level, '') + line + RESET
+    return line + '\n'
+
+
+class Decoder:
+    def __init__(self, formats, color):
+        self.formats = formats
+        self.color = color
+        self.pending = b''
+
+    def feed(self, data):
+        """Returns the bytes decoded, keeping a incomplete record to the next call"""
+        data = self.pending + data
+        self.pending = b''
+        out = []
+        i = 0
+        while i < len(data):
+            start = data.find(bytes([FRAME]), i)
+            if start < 0:
+                out.append(data[i:])
+                break
+            out.append(data[i:start])
+            if start + 2 > len(data) or start + 2 + data[start + 1] > len(data):
+                self.pending = data[start:]
+                break
+            end = start + 2 + data[start + 1]
+            line = decode_record(self.formats, data[start + 2:end], self.color)
+            if line is None:
+                out.append(data[start:start + 1])
+                i = start + 1
+            else:
+                out.append(line.encode())
+                i = end
+        return b''.join(out)
+
+    def flush(self):
+        data, self.pending = self.pending, b''
+        return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodes lg binary records')
+    parser.add_argument('elf', help='firmware ELF file')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='captured log (default: stdin)')
+    parser.add_argument('--color', action='store_true',
+                        help='color the records as esp_log')
+    parser.add_argument('--list', action='store_true',
+                        help='list the format strings and exit')
+    args = parser.parse_args()
+
+    try:
+        formats = read_formats(args.elf)
+    except (OSError, ValueError) as e:
+        sys.exit(f'error: {e}')
+
+    if args.list:
+        for id, (signature, fmt) in sorted(formats.items()):
+            print(f'{id:08x} {signature or "-":8} {fmt!r}')
+        return
+
+    decoder = Decoder(formats, args.color)
+    stream = sys.stdin.buffer if args.input == '-' else open(args.input, 'rb')
+    with stream:
+        while True:
+            data = stream.read1(4096) if hasattr(stream, 'read1') else stream.read(4096)
+            if not data:
+                break
+            sys.stdout.buffer.write(decoder.feed(data))
+            sys.stdout.buffer.flush()
+    sys.stdout.buffer.write(decoder.flush())
+
+
+if __name__ == '__main__':
+    main()